@@ -3,6 +3,8 @@
 #include "GMCPawn.h"
 #include "Ability/Tasks/GMCAbilityTaskBase.h"
 #include "Components/GMCAbilityComponent.h"
+#include "Engine/LatentActionManager.h"
+#include "TimerManager.h"
 
 UWorld* UGMCAbility::GetWorld() const
 {
@@ -41,16 +43,6 @@ void UGMCAbility::Tick(float DeltaTime)
 	// Don't tick before the ability is initialized or after it has ended
 	if (AbilityState == EAbilityState::PreExecution || AbilityState == EAbilityState::Ended) return;
 
-	if (!OwnerAbilityComponent->HasAuthority())
-	{
-		if (!bServerConfirmed && ClientStartTime + ServerConfirmTimeout < OwnerAbilityComponent->ActionTimer)
-		{
-			UE_LOG(LogGMCAbilitySystem, Error, TEXT("Ability Not Confirmed By Server: %d, Removing..."), AbilityID);
-			EndAbility();
-			return;
-		}
-	}
-
 	if (bEndPending) {
 		EndAbility();
 		return;
@@ -93,27 +85,70 @@ void UGMCAbility::Execute(UGMC_AbilitySystemComponent* InAbilityComponent, int I
 	this->AbilityInputAction = InputAction;
 	this->AbilityID = InAbilityID;
 	this->OwnerAbilityComponent = InAbilityComponent;
-	this->ClientStartTime = InAbilityComponent->ActionTimer;
 	PreBeginAbility();
 }
 
+void UGMCAbility::ResetAbility()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearAllTimersForObject(this);
+		World->GetLatentActionManager().RemoveActionsForObject(this);
+	}
+
+	// Properties added by subclasses (including Blueprint variables) go back to their class defaults. Instanced
+	// subobjects are skipped: copying would point this instance at the class defaults' own subobjects, so it keeps
+	// the ones it was created with.
+	const UGMCAbility* AbilityCDO = GetClass()->GetDefaultObject<UGMCAbility>();
+	for (TFieldIterator<FProperty> It(GetClass()); It; ++It)
+	{
+		const UClass* OwnerClass = It->GetOwnerClass();
+		if (!OwnerClass || !OwnerClass->IsChildOf(UGMCAbility::StaticClass()) || OwnerClass == UGMCAbility::StaticClass()) continue;
+		if (It->HasAnyPropertyFlags(CPF_InstancedReference | CPF_ContainsInstancedReference)) continue;
+
+		It->CopyCompleteValue_InContainer(this, AbilityCDO);
+	}
+
+	AbilityState = EAbilityState::PreExecution;
+	AbilityData = FGMCAbilityData();
+	AbilityInputAction = nullptr;
+	RunningTasks.Reset();
+	ActiveTasks.Reset();
+	DeclaredEffect.Reset();
+	AbilityCostInstance = nullptr;
+	BlockOtherAbility = AbilityCDO->BlockOtherAbility;
+	BlockOtherAbilitiesQuery = AbilityCDO->BlockOtherAbilitiesQuery;
+
+	AbilityID = -1;
+	TaskIDCounter = -1;
+	bEndPending = false;
+	bRunningTagsRegistered = false;
+
+	ResetAbilityEvent();
+}
+
 bool UGMCAbility::CanAffordAbilityCost(float DeltaTime) const
 {
-	if (AbilityCost == nullptr || OwnerAbilityComponent == nullptr) return true;
+	return CanAffordAbilityCostOn(OwnerAbilityComponent, DeltaTime);
+}
 
+bool UGMCAbility::CanAffordAbilityCostOn(const UGMC_AbilitySystemComponent* AbilityComponent, float DeltaTime) const
+{
+	if (AbilityCost == nullptr || AbilityComponent == nullptr) return true;
+
+	// The cost's class defaults have no owner, so attribute-based and custom modifiers are pointed at the component
+	// being checked instead.
 	UGMCAbilityEffect* AbilityEffect = AbilityCost->GetDefaultObject<UGMCAbilityEffect>();
-	for (FGMCAttributeModifier AttributeModifier : AbilityEffect->EffectData.Modifiers)
+	for (FGMCAttributeModifier AttributeModifier : AbilityEffect->GetDefinition().Modifiers)
 	{
-		for (const FAttribute* Attribute : OwnerAbilityComponent->GetAllAttributes())
+		int32 AttributeSlot = INDEX_NONE;
+		const FAttribute* Attribute = AbilityComponent->GetAttributeByTag(AttributeModifier.AttributeTag, AttributeSlot);
+		if (!Attribute) continue;
+
+		AttributeModifier.InitModifierFor(AbilityComponent, AbilityEffect, AbilityComponent->ActionTimer, DeltaTime);
+		if (Attribute->Value + AttributeModifier.CalculateModifierValue(*Attribute) < 0.f)
 		{
-			if (Attribute->Tag.MatchesTagExact(AttributeModifier.AttributeTag))
-			{
-				AttributeModifier.InitModifier(AbilityEffect, OwnerAbilityComponent->ActionTimer, -1.f, false, DeltaTime);
-				if (Attribute->Value + AttributeModifier.CalculateModifierValue(*Attribute) < 0.f)
-				{
-					return false;
-				}
-			}
+			return false;
 		}
 	}
 
@@ -129,18 +164,17 @@ void UGMCAbility::CommitAbilityCostAndCooldown()
 void UGMCAbility::CommitAbilityCooldown()
 {
 	if (CooldownTime <= 0.f || OwnerAbilityComponent == nullptr) return;
-	OwnerAbilityComponent->SetCooldownForAbility(AbilityTag, CooldownTime);
+	OwnerAbilityComponent->ConsumeChargeForAbility(AbilityTag, CooldownTime, MaxCharges);
 }
 
 void UGMCAbility::CommitAbilityCost()
 {
 	if (AbilityCost == nullptr || OwnerAbilityComponent == nullptr) return;
 
-	const UGMCAbilityEffect* EffectCDO = DuplicateObject(AbilityCost->GetDefaultObject<UGMCAbilityEffect>(), this);
-	FGMCAbilityEffectData EffectData = EffectCDO->EffectData;
-	EffectData.OwnerAbilityComponent = OwnerAbilityComponent;
-	EffectData.SourceAbilityComponent = OwnerAbilityComponent;
-	AbilityCostInstance = OwnerAbilityComponent->ApplyAbilityEffect(DuplicateObject(EffectCDO, this), EffectData);
+	FGMCAbilityEffectInstanceData InstanceData;
+	InstanceData.EffectClass = AbilityCost;
+	InstanceData.SourceAbilityComponent = OwnerAbilityComponent;
+	AbilityCostInstance = OwnerAbilityComponent->ApplyAbilityEffect(NewObject<UGMCAbilityEffect>(this, AbilityCost), InstanceData);
 }
 
 void UGMCAbility::RemoveAbilityCost() {
@@ -151,6 +185,8 @@ void UGMCAbility::RemoveAbilityCost() {
 
 
 void UGMCAbility::ModifyBlockOtherAbility(FGameplayTagContainer TagToAdd, FGameplayTagContainer TagToRemove) {
+	if (bRunningTagsRegistered) OwnerAbilityComponent->RemoveRunningAbilityTags(this);
+
 	for (auto Tag : TagToAdd) {
 		BlockOtherAbility.AddTag(Tag);
 	}
@@ -158,11 +194,15 @@ void UGMCAbility::ModifyBlockOtherAbility(FGameplayTagContainer TagToAdd, FGamep
 	for (auto Tag : TagToRemove) {
 		BlockOtherAbility.RemoveTag(Tag);
 	}
+
+	if (bRunningTagsRegistered) OwnerAbilityComponent->AddRunningAbilityTags(this);
 }
 
 
 void UGMCAbility::ResetBlockOtherAbility() {
+	if (bRunningTagsRegistered) OwnerAbilityComponent->RemoveRunningAbilityTags(this);
 	BlockOtherAbility = GetClass()->GetDefaultObject<UGMCAbility>()->BlockOtherAbility;
+	if (bRunningTagsRegistered) OwnerAbilityComponent->AddRunningAbilityTags(this);
 }
 
 
@@ -186,7 +226,27 @@ void UGMCAbility::HandleTaskHeartbeat(int TaskID)
 	}
 }
 
+void UGMCAbility::EndAbilitiesBlockedByQueryOn(UGMC_AbilitySystemComponent* AbilityComponent) const
+{
+	if (BlockOtherAbilitiesQuery.IsEmpty()) return;
+
+	for (const auto& ActiveAbility : AbilityComponent->GetActiveAbilities())
+	{
+		if (BlockOtherAbilitiesQuery.Matches(ActiveAbility.Value->AbilityDefinition))
+		{
+			ActiveAbility.Value->SetPendingEnd();
+			UE_LOG(LogGMCAbilitySystem, Verbose, TEXT("Ability %s blocked ability %s (matching query)"),
+				*AbilityTag.ToString(), *ActiveAbility.Value->AbilityTag.ToString());
+		}
+	}
+}
+
 void UGMCAbility::CancelConflictingAbilities()
+{
+	CancelConflictingAbilitiesOn(OwnerAbilityComponent);
+}
+
+void UGMCAbility::CancelConflictingAbilitiesOn(UGMC_AbilitySystemComponent* AbilityComponent) const
 {
 	for (const auto& AbilityToCancelTag : CancelAbilitiesWithTag) {
 		if (AbilityTag == AbilityToCancelTag) {
@@ -194,14 +254,14 @@ void UGMCAbility::CancelConflictingAbilities()
 			continue;
 		}
 
-		if (OwnerAbilityComponent->EndAbilitiesByTag(AbilityToCancelTag)) {
+		if (AbilityComponent->EndAbilitiesByTag(AbilityToCancelTag)) {
 			UE_LOG(LogGMCAbilitySystem, Verbose, TEXT("Ability (tag) %s has been cancelled by (tag) %s"), *AbilityTag.ToString(), *AbilityToCancelTag.ToString());
 		}
 	}
 
 	if (!EndOtherAbilitiesQuery.IsEmpty())
 	{
-		for (const auto& ActiveAbility : OwnerAbilityComponent->GetActiveAbilities())
+		for (const auto& ActiveAbility : AbilityComponent->GetActiveAbilities())
 		{
 			if (ActiveAbility.Value == this) continue;
 
@@ -216,12 +276,6 @@ void UGMCAbility::CancelConflictingAbilities()
 }
 
 
-void UGMCAbility::ServerConfirm()
-{
-	bServerConfirmed = true;
-}
-
-
 void UGMCAbility::SetPendingEnd() {
 	bEndPending = true;
 }
@@ -302,6 +356,12 @@ void UGMCAbility::FinishEndAbility() {
 		}
 	}
 
+	if (bRunningTagsRegistered)
+	{
+		OwnerAbilityComponent->RemoveRunningAbilityTags(this);
+		bRunningTagsRegistered = false;
+	}
+
 	AbilityState = EAbilityState::Ended;
 }
 
@@ -345,21 +405,10 @@ bool UGMCAbility::PreBeginAbility()
 	}
 
 
-	TArray<UGMCAbility*> ActiveAbilities;
-	OwnerAbilityComponent->GetActiveAbilities().GenerateValueArray(ActiveAbilities);
-
-	for (auto& OtherAbilityTag : BlockedByOtherAbility)
+	if (IsBlockedByActiveAbility(OwnerAbilityComponent))
 	{
-		if (ActiveAbilities.FindByPredicate([&OtherAbilityTag](const UGMCAbility* ActiveAbility) {
-			return ActiveAbility
-			&& ActiveAbility->IsActive()
-			&& ActiveAbility->AbilityTag.MatchesTag(OtherAbilityTag);
-		}))
-		{
-			UE_LOG(LogGMCAbilitySystem, Verbose, TEXT("Ability Activation for %s Stopped because Blocked By Other Ability (%s)"), *AbilityTag.ToString(), *OtherAbilityTag.ToString());
-			CancelAbility();
-			return false;
-		}
+		CancelAbility();
+		return false;
 	}
 	
 
@@ -376,28 +425,103 @@ bool UGMCAbility::PreBeginAbility()
 }
 
 
-void UGMCAbility::BeginAbility()
+bool UGMCAbility::IsBlockedByActiveAbility(const UGMC_AbilitySystemComponent* AbilityComponent) const
 {
+	if (AbilityComponent->GetRunningAbilityTags().HasAny(BlockedByOtherAbility))
+	{
+		UE_LOG(LogGMCAbilitySystem, Verbose, TEXT("Ability Activation for %s Stopped because Blocked By Other Ability (%s)"), *AbilityTag.ToString(), *BlockedByOtherAbility.ToStringSimple());
+		return true;
+	}
+	return false;
+}
 
+bool UGMCAbility::IsActivationTemporarilyBlocked(const UGMC_AbilitySystemComponent* AbilityComponent) const
+{
+	if (AbilityComponent->GetCooldownForAbility(AbilityTag) > 0)
+	{
+		UE_LOG(LogGMCAbilitySystem, Verbose, TEXT("Ability Activation for %s Stopped By Cooldown"), *AbilityTag.ToString());
+		return true;
+	}
 
-	OwnerAbilityComponent->OnAbilityActivated.Broadcast(this, AbilityTag);
+	if (IsBlockedByActiveAbility(AbilityComponent))
+	{
+		return true;
+	}
+
+	if (AbilityComponent->IsAbilityTagBlocked(AbilityTag)) {
+		UE_LOG(LogGMCAbilitySystem, Verbose, TEXT("Ability Activation for %s Stopped because Blocked By Other Ability"), *AbilityTag.ToString());
+		return true;
+	}
+
+	return false;
+}
 
-	if (!BlockOtherAbilitiesQuery.IsEmpty())
+bool UGMCAbility::ActivateNonInstanced(const FGMCAbilityActivationContext& Context) const
+{
+	UGMC_AbilitySystemComponent* AbilityComponent = Context.AbilityComponent;
+	if (!AbilityComponent) return false;
+
+	if (IsActivationTemporarilyBlocked(AbilityComponent))
 	{
-		FGameplayTagQuery BlockQuery = BlockOtherAbilitiesQuery;
-		for (auto& ActiveAbility : OwnerAbilityComponent->GetActiveAbilities())
-		{
-			const FGameplayTagContainer& ActiveAbilityTags = ActiveAbility.Value->AbilityDefinition;
+		return false;
+	}
 
-			if (BlockQuery.Matches(ActiveAbilityTags))
-			{
-				ActiveAbility.Value->SetPendingEnd();
-				UE_LOG(LogGMCAbilitySystem, Verbose, TEXT("Ability %s blocked ability %s (matching query)"),
-					*AbilityTag.ToString(), *ActiveAbility.Value->AbilityTag.ToString());
-			}
-		}
+	if (!CanAffordAbilityCostOn(AbilityComponent, 1.f))
+	{
+		UE_LOG(LogGMCAbilitySystem, Verbose, TEXT("Ability Activation for %s Stopped By Cost"), *AbilityTag.ToString());
+		return false;
+	}
+
+	// There's no instance, so the pre-execution check and listeners get the class default object.
+	UGMCAbility* MutableThis = const_cast<UGMCAbility*>(this);
+	if (!MutableThis->PreExecuteCheckEvent())
+	{
+		UE_LOG(LogGMCAbilitySystem, Verbose, TEXT("Ability Activation for %s Stopped By Failing PreExecution check"), *AbilityTag.ToString());
+		return false;
+	}
+
+	AbilityComponent->OnAbilityActivated.Broadcast(MutableThis, AbilityTag);
+
+	if (!ActivateNonInstancedEvent(Context))
+	{
+		UE_LOG(LogGMCAbilitySystem, Verbose, TEXT("Ability Activation for %s Stopped By Non-Instanced Activation"), *AbilityTag.ToString());
+		AbilityComponent->OnAbilityEnded.Broadcast(MutableThis);
+		return false;
+	}
+
+	if (CooldownTime > 0.f)
+	{
+		AbilityComponent->ConsumeChargeForAbility(AbilityTag, CooldownTime, MaxCharges);
 	}
 
+	if (AbilityCost)
+	{
+		FGMCAbilityEffectInstanceData InstanceData;
+		InstanceData.EffectClass = AbilityCost;
+		InstanceData.SourceAbilityComponent = AbilityComponent;
+		AbilityComponent->ApplyAbilityEffect(NewObject<UGMCAbilityEffect>(AbilityComponent, AbilityCost), InstanceData);
+	}
+
+	EndAbilitiesBlockedByQueryOn(AbilityComponent);
+	CancelConflictingAbilitiesOn(AbilityComponent);
+
+	AbilityComponent->OnAbilityEnded.Broadcast(MutableThis);
+	return true;
+}
+
+bool UGMCAbility::ActivateNonInstancedEvent_Implementation(const FGMCAbilityActivationContext& Context) const
+{
+	return true;
+}
+
+void UGMCAbility::BeginAbility()
+{
+
+
+	OwnerAbilityComponent->OnAbilityActivated.Broadcast(this, AbilityTag);
+
+	EndAbilitiesBlockedByQueryOn(OwnerAbilityComponent);
+
 	if (bApplyCooldownAtAbilityBegin)
 	{
 		CommitAbilityCooldown();
@@ -405,6 +529,8 @@ void UGMCAbility::BeginAbility()
 
 	// Initialize Ability
 	AbilityState = EAbilityState::Initialized;
+	OwnerAbilityComponent->AddRunningAbilityTags(this);
+	bRunningTagsRegistered = true;
 
 	// Cancel Abilities in CancelAbilitiesWithTag container
 	CancelConflictingAbilities();
@@ -2,3 +2,80 @@
 
 
 #include "Ability/GMCAbilityMapData.h"
+
+namespace
+{
+	struct FSharedAbilityMapTable
+	{
+		TArray<TWeakObjectPtr<const UGMCAbilityMapData>> Assets;
+		TWeakPtr<const FGMCAbilityMapTable> Table;
+	};
+
+	// Keyed by a hash of the asset list. Only touched from the game thread.
+	TMultiMap<uint32, FSharedAbilityMapTable> SharedAbilityMapTables;
+}
+
+TSharedRef<const FGMCAbilityMapTable> FGMCAbilityMapTable::Build(const TMap<FGameplayTag, FAbilityMapData>& AbilityMap)
+{
+	TSharedRef<FGMCAbilityMapTable> Table = MakeShared<FGMCAbilityMapTable>();
+	Table->Spans.Reserve(AbilityMap.Num());
+
+	int32 NumAbilities = 0;
+	for (const auto& Entry : AbilityMap)
+	{
+		NumAbilities += Entry.Value.Abilities.Num();
+	}
+	Table->Abilities.Reserve(NumAbilities);
+
+	for (const auto& Entry : AbilityMap)
+	{
+		FSpan& Span = Table->Spans.Add(Entry.Key);
+		Span.Start = Table->Abilities.Num();
+		Span.Num = Entry.Value.Abilities.Num();
+		Table->Abilities.Append(Entry.Value.Abilities);
+	}
+
+	return Table;
+}
+
+TSharedRef<const FGMCAbilityMapTable> FGMCAbilityMapTable::GetShared(const TArray<TObjectPtr<UGMCAbilityMapData>>& AbilityMapAssets,
+	const TMap<FGameplayTag, FAbilityMapData>& AbilityMap)
+{
+	check(IsInGameThread());
+
+	TArray<TWeakObjectPtr<const UGMCAbilityMapData>> Assets;
+	uint32 Hash = 0;
+	for (const UGMCAbilityMapData* Asset : AbilityMapAssets)
+	{
+		if (!Asset) continue;
+		Assets.Add(Asset);
+		Hash = HashCombine(Hash, GetTypeHash(Asset));
+	}
+
+	for (auto It = SharedAbilityMapTables.CreateKeyIterator(Hash); It; ++It)
+	{
+		TSharedPtr<const FGMCAbilityMapTable> Table = It.Value().Table.Pin();
+		if (!Table.IsValid())
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		if (It.Value().Assets == Assets)
+		{
+			return Table.ToSharedRef();
+		}
+	}
+
+	TSharedRef<const FGMCAbilityMapTable> Table = Build(AbilityMap);
+	SharedAbilityMapTables.Add(Hash, { MoveTemp(Assets), Table });
+	return Table;
+}
+
+TConstArrayView<TSubclassOf<UGMCAbility>> FGMCAbilityMapTable::Find(const FGameplayTag& InputTag) const
+{
+	const FSpan* Span = Spans.Find(InputTag);
+	if (!Span) return {};
+
+	return TConstArrayView<TSubclassOf<UGMCAbility>>(Abilities.GetData() + Span->Start, Span->Num);
+}
@@ -34,8 +34,8 @@ void UGMCAbilityTaskBase::Tick(float DeltaTime)
 }
 
 void UGMCAbilityTaskBase::AncillaryTick(float DeltaTime){
-	// Locally controlled server pawns don't need to send heartbeats
-	if (AbilitySystemComponent->GMCMovementComponent->IsLocallyControlledServerPawn()) return;
+	// Locally controlled server pawns, and components with no client at all, don't need heartbeats
+	if (AbilitySystemComponent->IsAuthorityOnly() || AbilitySystemComponent->GMCMovementComponent->IsLocallyControlledServerPawn()) return;
 	
 	// If not the server version of the component, send heartbeats
 	if (AbilitySystemComponent->GetNetMode() != NM_DedicatedServer &&
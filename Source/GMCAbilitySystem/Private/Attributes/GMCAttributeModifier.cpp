@@ -1,6 +1,7 @@
 #include "Attributes/GMCAttributeModifier.h"
 
 #include "GMCAbilityComponent.h"
+#include "UObject/CoreNet.h"
 
 float FGMCAttributeModifier::GetValue() const
 {
@@ -11,19 +12,19 @@ float FGMCAttributeModifier::GetValue() const
 		return ModifierValue;
 	case EGMCAttributeModifierType::AMT_Attribute:
 		{
-			if (SourceAbilityEffect.IsValid() && SourceAbilityEffect->GetOwnerAbilityComponent())
+			if (const UGMC_AbilitySystemComponent* Component = GetEvaluationComponent())
 			{
-				return SourceAbilityEffect->GetOwnerAbilityComponent()->GetAttributeValueByTag(ValueAsAttribute);
+				return Component->GetAttributeValueByTag(ValueAsAttribute);
 			}
 			UE_LOG(LogGMCAbilitySystem, Error, TEXT("SourceAbilityEffect is null in FAttribute::AddModifier"));
 			return 0.f;
 		}
 	case EGMCAttributeModifierType::AMT_Custom:
-		if (CustomModifierClass && SourceAbilityEffect.IsValid() && SourceAbilityEffect->GetOwnerAbilityComponent())
+		if (CustomModifierClass && SourceAbilityEffect.IsValid() && GetEvaluationComponent())
 		{
 			if (UGMCAttributeModifierCustom_Base* CustomModifier = CustomModifierClass->GetDefaultObject<UGMCAttributeModifierCustom_Base>())
 			{
-				return CustomModifier->Calculate(SourceAbilityEffect.Get(), SourceAbilityEffect->GetOwnerAbilityComponent()->GetAttributeByTag(AttributeTag));
+				return CustomModifier->Calculate(SourceAbilityEffect.Get(), GetEvaluationComponent()->GetAttributeByTag(AttributeTag));
 			}
 			UE_LOG(LogGMCAbilitySystem, Error, TEXT("Custom Modifier Class is null in FAttribute::AddModifier"));
 		}
@@ -63,15 +64,15 @@ float FGMCAttributeModifier::CalculateModifierValue(const FAttribute& Attribute)
 		case EModifierType::AddPercentageInitialValue:
 			return Attribute.InitialValue * TargetValue * DeltaTime;
 		case EModifierType::AddPercentageAttribute:
-			return SourceAbilityEffect->GetOwnerAbilityComponent()->GetAttributeValueByTag(ValueAsAttribute) * TargetValue * DeltaTime;
+			return GetAttributeValue(ValueAsAttribute) * TargetValue * DeltaTime;
 		case EModifierType::AddPercentageMaxClamp:
 			{
-				const float MaxValue = Attribute.Clamp.MaxAttributeTag.IsValid() ? SourceAbilityEffect->GetOwnerAbilityComponent()->GetAttributeValueByTag(Attribute.Clamp.MaxAttributeTag) : Attribute.Clamp.Max;
+				const float MaxValue = Attribute.Clamp.MaxAttributeTag.IsValid() ? GetAttributeValue(Attribute.Clamp.MaxAttributeTag) : Attribute.Clamp.Max;
 				return MaxValue * TargetValue * DeltaTime;
 			}
 		case EModifierType::AddPercentageMinClamp:
 			{
-				const float MinValue = Attribute.Clamp.MinAttributeTag.IsValid() ? SourceAbilityEffect->GetOwnerAbilityComponent()->GetAttributeValueByTag(Attribute.Clamp.MinAttributeTag) : Attribute.Clamp.Min;
+				const float MinValue = Attribute.Clamp.MinAttributeTag.IsValid() ? GetAttributeValue(Attribute.Clamp.MinAttributeTag) : Attribute.Clamp.Min;
 				return MinValue * TargetValue * DeltaTime;
 			}
 		case EModifierType::AddPercentageAttributeSum:
@@ -79,20 +80,20 @@ float FGMCAttributeModifier::CalculateModifierValue(const FAttribute& Attribute)
 				float Sum = 0.f;
 				for (auto& AttTag : Attributes)
 				{
-					Sum += SourceAbilityEffect->GetOwnerAbilityComponent()->GetAttributeValueByTag(AttTag);
+					Sum += GetAttributeValue(AttTag);
 				}
 				return TargetValue * Sum * DeltaTime;
 			}
 		case EModifierType::AddScaledBetween:
 			{
-				const float XBound = XAsAttribute ? SourceAbilityEffect->GetOwnerAbilityComponent()->GetAttributeValueByTag(XAttribute) : X;
-				const float YBound = YAsAttribute ? SourceAbilityEffect->GetOwnerAbilityComponent()->GetAttributeValueByTag(YAttribute) : Y;
+				const float XBound = XAsAttribute ? GetAttributeValue(XAttribute) : X;
+				const float YBound = YAsAttribute ? GetAttributeValue(YAttribute) : Y;
 				return FMath::Clamp(FMath::Lerp(XBound, YBound, TargetValue), X, Y) * DeltaTime;
 			}
 		case EModifierType::AddClampedBetween:
 			{
-				const float XBound = XAsAttribute ? SourceAbilityEffect->GetOwnerAbilityComponent()->GetAttributeValueByTag(XAttribute) : X;
-				const float YBound = YAsAttribute ? SourceAbilityEffect->GetOwnerAbilityComponent()->GetAttributeValueByTag(YAttribute) : Y;
+				const float XBound = XAsAttribute ? GetAttributeValue(XAttribute) : X;
+				const float YBound = YAsAttribute ? GetAttributeValue(YAttribute) : Y;
 				return FMath::Clamp(TargetValue, XBound, YBound) * DeltaTime;
 			}
 		case EModifierType::AddPercentageMissing:
@@ -102,7 +103,8 @@ float FGMCAttributeModifier::CalculateModifierValue(const FAttribute& Attribute)
 			}
 		case EModifierType::AddPercentageOfAttributeRawValue:
 			{
-				const float RawValue = SourceAbilityEffect->GetOwnerAbilityComponent()->GetAttributeRawValue(Attribute.Tag);
+				const UGMC_AbilitySystemComponent* Component = GetEvaluationComponent();
+				const float RawValue = Component ? Component->GetAttributeRawValue(Attribute.Tag) : 0.f;
 				return TargetValue * RawValue * DeltaTime;
 			}
 	}
@@ -121,9 +123,81 @@ void FGMCAttributeModifier::InitModifier(UGMCAbilityEffect* Effect, double InAct
 	}
 
 	SourceAbilityEffect = Effect;
+	EvaluationComponent = nullptr;
 	bRegisterInHistory = bInRegisterInHistory;
 	DeltaTime = InDeltaTime;
 	ApplicationIndex = InApplicationIdx;
 	ActionTimer = InActionTimer;
 	
 }
+
+void FGMCAttributeModifier::InitModifierFor(const UGMC_AbilitySystemComponent* AbilityComponent, UGMCAbilityEffect* Effect, double InActionTimer, float InDeltaTime)
+{
+	InitModifier(Effect, InActionTimer, -1, false, InDeltaTime);
+	EvaluationComponent = AbilityComponent;
+}
+
+const UGMC_AbilitySystemComponent* FGMCAttributeModifier::GetEvaluationComponent() const
+{
+	if (EvaluationComponent.IsValid())
+	{
+		return EvaluationComponent.Get();
+	}
+	return SourceAbilityEffect.IsValid() ? SourceAbilityEffect->GetOwnerAbilityComponent() : nullptr;
+}
+
+float FGMCAttributeModifier::GetAttributeValue(const FGameplayTag& Tag) const
+{
+	if (const UGMC_AbilitySystemComponent* Component = GetEvaluationComponent())
+	{
+		return Component->GetAttributeValueByTag(Tag);
+	}
+	UE_LOG(LogGMCAbilitySystem, Error, TEXT("No ability component to read attribute %s from in FGMCAttributeModifier::CalculateModifierValue"), *Tag.ToString());
+	return 0.f;
+}
+
+bool FGMCAttributeModifier::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = true;
+
+	Ar << ValueType;
+	Ar << Op;
+
+	uint8 bXAsAttribute = XAsAttribute;
+	uint8 bYAsAttribute = YAsAttribute;
+	Ar.SerializeBits(&bXAsAttribute, 1);
+	Ar.SerializeBits(&bYAsAttribute, 1);
+	XAsAttribute = bXAsAttribute != 0;
+	YAsAttribute = bYAsAttribute != 0;
+
+	bool bFieldSuccess = true;
+	AttributeTag.NetSerialize(Ar, Map, bFieldSuccess);
+	bOutSuccess &= bFieldSuccess;
+	ValueAsAttribute.NetSerialize(Ar, Map, bFieldSuccess);
+	bOutSuccess &= bFieldSuccess;
+	XAttribute.NetSerialize(Ar, Map, bFieldSuccess);
+	bOutSuccess &= bFieldSuccess;
+	YAttribute.NetSerialize(Ar, Map, bFieldSuccess);
+	bOutSuccess &= bFieldSuccess;
+	MetaTags.NetSerialize(Ar, Map, bFieldSuccess);
+	bOutSuccess &= bFieldSuccess;
+	Attributes.NetSerialize(Ar, Map, bFieldSuccess);
+	bOutSuccess &= bFieldSuccess;
+
+	Ar << ModifierValue;
+	Ar << X;
+	Ar << Y;
+
+	// Custom modifier classes need a package map to resolve; without one (local archives) the class is left untouched.
+	if (Map)
+	{
+		UObject* CustomClassObject = CustomModifierClass.Get();
+		bOutSuccess &= Map->SerializeObject(Ar, UClass::StaticClass(), CustomClassObject);
+		if (Ar.IsLoading())
+		{
+			CustomModifierClass = Cast<UClass>(CustomClassObject);
+		}
+	}
+
+	return true;
+}
@@ -91,31 +91,86 @@ void UGMC_AbilitySystemComponent::BindReplicationData()
 			EGMC_InterpolationFunction::TargetValue);
 	}
 	
+	// Active Tags
+	GMCMovementComponent->BindGameplayTagContainer(ActiveTags,
+		EGMC_PredictionMode::ServerAuth_Output_ClientValidated,
+		EGMC_CombineMode::CombineIfUnchanged,
+		EGMC_SimulationMode::Periodic_Output,
+		EGMC_InterpolationFunction::TargetValue);
+
+	GMCMovementComponent->BindBool(bJustTeleported,
+		EGMC_PredictionMode::ServerAuth_Output_ClientValidated,
+		EGMC_CombineMode::CombineIfUnchanged,
+		EGMC_SimulationMode::PeriodicAndOnChange_Output,
+		EGMC_InterpolationFunction::TargetValue);
+
+	// Set up our operation queues.
+	QueuedAbilityOperations.MaxOperationsPerMove = MaxQueuedOperationsPerMove;
+	QueuedEffectOperations.MaxOperationsPerMove = MaxQueuedOperationsPerMove;
+	QueuedEffectOperations_ClientAuth.MaxOperationsPerMove = MaxQueuedOperationsPerMove;
+	QueuedEventOperations.MaxOperationsPerMove = MaxQueuedOperationsPerMove;
+	if (QueuedOperationDrainOrder.Num() > 0)
+	{
+		QueuedAbilityOperations.LaneDrainOrder = QueuedOperationDrainOrder;
+		QueuedEffectOperations.LaneDrainOrder = QueuedOperationDrainOrder;
+		QueuedEffectOperations_ClientAuth.LaneDrainOrder = QueuedOperationDrainOrder;
+		QueuedEventOperations.LaneDrainOrder = QueuedOperationDrainOrder;
+	}
+	QueuedAbilityOperations.ClassRegistry = &ClassRegistry;
+	QueuedEffectOperations.ClassRegistry = &ClassRegistry;
+	QueuedEffectOperations_ClientAuth.ClassRegistry = &ClassRegistry;
+	QueuedEventOperations.ClassRegistry = &ClassRegistry;
+
+	// Everything past here only exists to predict and correct an owning client.
+	if (bServerOnlyMode)
+	{
+		QueuedAbilityOperations.InitializeUnbound();
+		QueuedEffectOperations.InitializeUnbound();
+		QueuedEffectOperations_ClientAuth.InitializeUnbound();
+		QueuedEventOperations.InitializeUnbound();
+		return;
+	}
+
 	// Granted Abilities
 	GMCMovementComponent->BindGameplayTagContainer(GrantedAbilityTags,
 		EGMC_PredictionMode::ServerAuth_Output_ClientValidated,
 		EGMC_CombineMode::CombineIfUnchanged,
 		EGMC_SimulationMode::None,
 		EGMC_InterpolationFunction::TargetValue);
+	
+	// Cooldowns
+	GMCMovementComponent->BindInstancedStruct(CooldownData,
+		EGMC_PredictionMode::ServerAuth_Output_ClientValidated,
+		EGMC_CombineMode::CombineIfUnchanged,
+		EGMC_SimulationMode::None,
+		EGMC_InterpolationFunction::TargetValue);
 
-	// Active Tags
-	GMCMovementComponent->BindGameplayTagContainer(ActiveTags,
+	// Ability activations and ends
+	GMCMovementComponent->BindInstancedStruct(BoundAbilityState,
 		EGMC_PredictionMode::ServerAuth_Output_ClientValidated,
 		EGMC_CombineMode::CombineIfUnchanged,
-		EGMC_SimulationMode::Periodic_Output,
+		EGMC_SimulationMode::None,
+		EGMC_InterpolationFunction::TargetValue);
+
+	// Buffered ability inputs
+	GMCMovementComponent->BindInstancedStruct(AbilityInputBuffer,
+		EGMC_PredictionMode::ServerAuth_Output_ClientValidated,
+		EGMC_CombineMode::CombineIfUnchanged,
+		EGMC_SimulationMode::None,
 		EGMC_InterpolationFunction::TargetValue);
 	
-	// TaskData Bind
-	GMCMovementComponent->BindInstancedStruct(TaskData,
+	// Class registry handshake
+	GMCMovementComponent->BindBool(bClassRegistryMatchesServer,
 		EGMC_PredictionMode::ClientAuth_Input,
 		EGMC_CombineMode::CombineIfUnchanged,
 		EGMC_SimulationMode::None,
 		EGMC_InterpolationFunction::TargetValue);
 
-	GMCMovementComponent->BindBool(bJustTeleported,
-		EGMC_PredictionMode::ServerAuth_Output_ClientValidated,
+	// TaskData Bind
+	GMCMovementComponent->BindInstancedStruct(TaskData,
+		EGMC_PredictionMode::ClientAuth_Input,
 		EGMC_CombineMode::CombineIfUnchanged,
-		EGMC_SimulationMode::PeriodicAndOnChange_Output,
+		EGMC_SimulationMode::None,
 		EGMC_InterpolationFunction::TargetValue);
 
 	// Bind our operation queues.
@@ -136,6 +191,8 @@ void UGMC_AbilitySystemComponent::GenAncillaryTick(float DeltaTime, bool bIsComb
 	ServerHandlePendingEffect(DeltaTime);
 
 	ClientHandlePendingOperation(QueuedEventOperations);
+
+	ReconcileBoundAbilityState();
 	
 	CheckActiveTagsChanged();
 	
@@ -145,14 +202,12 @@ void UGMC_AbilitySystemComponent::GenAncillaryTick(float DeltaTime, bool bIsComb
 	
 	CheckUnBoundAttributeChanged();
 	
-	TickActiveCooldowns(DeltaTime);
-
 	SendTaskDataToActiveAbility(false);
 	TickAncillaryActiveAbilities(DeltaTime);
 
-	// Check if we have a valid operation
+	// Check if we have any valid operations, in the order they were queued
 	TGMASBoundQueueOperation<UGMCAbility, FGMCAbilityData> Operation;
-	if (QueuedAbilityOperations.GetCurrentBoundOperation(Operation, true))
+	for (int32 Idx = 0; QueuedAbilityOperations.GetCurrentBoundOperation(Idx, Operation); Idx++)
 	{
 		ProcessAbilityOperation(Operation, false);
 	}
@@ -173,7 +228,7 @@ TArray<UGMCAbilityEffect*> UGMC_AbilitySystemComponent::GetActiveEffectsByTag(FG
 	TArray<UGMCAbilityEffect*> ActiveEffectsFound;
 
 	for (const TTuple<int, UGMCAbilityEffect*>& EffectFound : ActiveEffects) {
-		if (IsValid(EffectFound.Value) && bMatchExact ? EffectFound.Value->EffectData.EffectTag.MatchesTagExact(GameplayTag) : EffectFound.Value->EffectData.EffectTag.MatchesTag(GameplayTag)) {
+		if (IsValid(EffectFound.Value) && bMatchExact ? EffectFound.Value->GetDefinition().EffectTag.MatchesTagExact(GameplayTag) : EffectFound.Value->GetDefinition().EffectTag.MatchesTag(GameplayTag)) {
 			ActiveEffectsFound.Add(EffectFound.Value);
 		}
 	}
@@ -185,7 +240,7 @@ TArray<UGMCAbilityEffect*> UGMC_AbilitySystemComponent::GetActiveEffectsByTag(FG
 UGMCAbilityEffect* UGMC_AbilitySystemComponent::GetFirstActiveEffectByTag(FGameplayTag GameplayTag) const
 {
 	for (auto& EffectFound : ActiveEffects) {
-		if (EffectFound.Value && EffectFound.Value->EffectData.EffectTag.MatchesTag(GameplayTag)) {
+		if (EffectFound.Value && EffectFound.Value->GetDefinition().EffectTag.MatchesTag(GameplayTag)) {
 			return EffectFound.Value;
 		}
 	}
@@ -301,27 +356,53 @@ TArray<FGameplayTag> UGMC_AbilitySystemComponent::GetActiveTagsByParentTag(const
 	return MatchedTags;
 }
 
-void UGMC_AbilitySystemComponent::TryActivateAbilitiesByInputTag(const FGameplayTag& InputTag, const UInputAction* InputAction, bool bFromMovementTick)
+bool UGMC_AbilitySystemComponent::TryActivateAbilitiesByInputTag(const FGameplayTag& InputTag, const UInputAction* InputAction, bool bFromMovementTick)
 {
+	bool bTriedAny = false;
+	bool bActivatedAny = false;
+
+	// Activating an ability can change the ability map, so keep the table we're iterating alive.
+	const TSharedRef<const FGMCAbilityMapTable> PinnedAbilityMapTable = GetAbilityMapTable();
 	for (const TSubclassOf<UGMCAbility>& ActivatedAbility : GetGrantedAbilitiesByTag(InputTag))
 	{
 		const UGMCAbility* AbilityCDO = ActivatedAbility->GetDefaultObject<UGMCAbility>();
 		if(AbilityCDO && bFromMovementTick == AbilityCDO->bActivateOnMovementTick){
 			UE_LOG(LogGMCAbilitySystem, VeryVerbose, TEXT("Trying to Activate Ability: %s from %s"), *GetNameSafe(ActivatedAbility), bFromMovementTick ? TEXT("Movement") : TEXT("Ancillary"));
-			TryActivateAbility(ActivatedAbility, InputAction, InputTag);
+			bTriedAny = true;
+			bActivatedAny |= TryActivateAbility(ActivatedAbility, InputAction, InputTag);
 		}
 	}
+
+	return bActivatedAny || !bTriedAny;
 }
 
 bool UGMC_AbilitySystemComponent::TryActivateAbility(const TSubclassOf<UGMCAbility> ActivatedAbility, const UInputAction* InputAction, const FGameplayTag ActivationTag)
 {
 	
 	if (ActivatedAbility == nullptr) return false;
-	
+
+	// A replayed move re-runs activations whose abilities are still active. Record them again rather than refusing,
+	// or the corrected state would read as the server having refused them.
+	if (bInPredictionTick && GMCMovementComponent->CL_IsReplaying())
+	{
+		FGMCBoundAbilityState& State = GetBoundAbilityState();
+		const int32 ReplayedID = State.FindReplayedActivation(ActionTimer,
+			[this](int32 Id) { return ActiveAbilities.Contains(Id); },
+			[this, &ActivatedAbility](int32 Id)
+			{
+				const UGMCAbility* Ability = ActiveAbilities.FindRef(Id);
+				return Ability && Ability->GetClass() == ActivatedAbility;
+			});
+		if (ReplayedID != FGMASIdAllocator::InvalidId)
+		{
+			State.ActivatedAbilities.Add(ReplayedID);
+			return true;
+		}
+	}
 	
 	// Generated ID is based on ActionTimer so it always lines up on client/server
 	// Also helps when dealing with replays
-	int AbilityID = GenerateAbilityID();
+	const int AbilityID = GenerateAbilityID();
 
 	const UGMCAbility* AbilityCDO = ActivatedAbility->GetDefaultObject<UGMCAbility>();
 	if (!AbilityCDO->bAllowMultipleInstances)
@@ -339,22 +420,43 @@ bool UGMC_AbilitySystemComponent::TryActivateAbility(const TSubclassOf<UGMCAbili
 		return false;
 	}
 
-	// If multiple abilities are activated on the same frame, add 1 to the ID
-	// This should never actually happen as abilities get queued
-	while (ActiveAbilities.Contains(AbilityID)){
-		AbilityID += 1;
+	// Checked again once the ability begins, but catching it here tells the input buffer to retry.
+	if (AbilityCDO->IsActivationTemporarilyBlocked(this))
+	{
+		return false;
+	}
+
+	if (AbilityID == FGMASIdAllocator::InvalidId)
+	{
+		UE_LOG(LogGMCAbilitySystem, Error, TEXT("Ability Activation for %s Stopped (No Available Ability ID)"), *GetNameSafe(ActivatedAbility));
+		return false;
 	}
 	
 	UE_LOG(LogGMCAbilitySystem, VeryVerbose, TEXT("[Server: %hhd] Generated Ability Activation ID: %d"), HasAuthority(), AbilityID);
+
+	// Non-instanced abilities are over by the time this returns, so there's nothing to track or confirm.
+	if (AbilityCDO->InstancingPolicy == EGMCAbilityInstancingPolicy::NonInstanced)
+	{
+		FGMCAbilityActivationContext Context;
+		Context.AbilityComponent = this;
+		Context.AbilityID = AbilityID;
+		Context.AbilityData = AbilityData;
+		Context.AbilityData.InputTag = ActivationTag;
+		Context.InputAction = InputAction;
+		return AbilityCDO->ActivateNonInstanced(Context);
+	}
 	
-	UGMCAbility* Ability = NewObject<UGMCAbility>(this, ActivatedAbility);
+	UGMCAbility* Ability = AcquireAbilityInstance(ActivatedAbility);
 	Ability->AbilityData = AbilityData;
 	Ability->AbilityData.InputTag = ActivationTag;
 	
 	Ability->Execute(this, AbilityID, InputAction);
-	ActiveAbilities.Add(AbilityID, Ability);
-	
-	if (HasAuthority()) {RPCConfirmAbilityActivation(AbilityID);}
+	AddActiveAbility(AbilityID, Ability);
+	GetWritableBoundAbilityState().ActivatedAbilities.Add(AbilityID);
+	if (!bInPredictionTick && !HasAuthority())
+	{
+		OutsideMoveActivations.Add(AbilityID, ActionTimer);
+	}
 
 	return true;
 }
@@ -369,16 +471,17 @@ void UGMC_AbilitySystemComponent::QueueAbility(FGameplayTag InputTag, const UInp
 
 
 	// Early local check for ability
-	FAbilityMapData* MapEntry = AbilityMap.Find(InputTag);
-	if (MapEntry == nullptr || MapEntry->Abilities.IsEmpty()) return;
+	const TConstArrayView<TSubclassOf<UGMCAbility>> MappedAbilities = GetAbilityMapTable()->Find(InputTag);
+	if (MappedAbilities.IsEmpty()) return;
+
+	// Repeated presses before the next move would only activate (or buffer) the same abilities again.
+	if (bDeduplicateQueuedAbilityInputs && QueuedAbilityOperations.NumMatching(InputTag, EGMASBoundQueueOperationType::Activate) > 0) return;
 
 	// This local check will prevent concurrent activation of the same ability if the ability is contain in the input map
 	if (bPreventConcurrentActivation) {
-		for (const TPair<int, UGMCAbility*>& ActiveAbility : ActiveAbilities)
+		for (const TSubclassOf<UGMCAbility>& Ability : MappedAbilities)
 		{
-			if (ActiveAbility.Value && MapEntry->Abilities.ContainsByPredicate([&ActiveAbility](const TSubclassOf<UGMCAbility>& Ability) {
-					return ActiveAbility.Value->IsA(Ability);
-				})) return;
+			if (ActiveAbilityIdsByClass.Contains(Ability.Get())) return;
 		}
 	}
 
@@ -395,42 +498,228 @@ int32 UGMC_AbilitySystemComponent::GetQueuedAbilityCount(FGameplayTag AbilityTag
 
 int32 UGMC_AbilitySystemComponent::GetActiveAbilityCount(TSubclassOf<UGMCAbility> AbilityClass)
 {
-	int32 Result = 0;
+	return CountActiveAbilities(AbilityClass);
+}
 
-	for (const auto& ActiveAbilityData : ActiveAbilities)
+
+int32 UGMC_AbilitySystemComponent::CountActiveAbilities(TSubclassOf<UGMCAbility> AbilityClass) const
+{
+	const TArray<int32>* AbilityIds = ActiveAbilityIdsByClass.Find(AbilityClass.Get());
+	if (!AbilityIds) return 0;
+
+	int32 Result = 0;
+	for (const int32 AbilityID : *AbilityIds)
 	{
-		if (ActiveAbilityData.Value->IsA(AbilityClass) && ActiveAbilityData.Value->AbilityState != EAbilityState::Ended) Result++;
+		if (ActiveAbilities.FindChecked(AbilityID)->AbilityState != EAbilityState::Ended) Result++;
 	}
 
 	return Result;
 }
 
 
-bool UGMC_AbilitySystemComponent::IsAbilityTagBlocked(const FGameplayTag AbilityTag) const {
-	
-	for (const auto& ActiveAbility : ActiveAbilities) {
-		if (IsValid(ActiveAbility.Value) && ActiveAbility.Value->AbilityState != EAbilityState::Ended)
+bool UGMC_AbilitySystemComponent::CanActivateAbility(TSubclassOf<UGMCAbility> AbilityClass, EGMCAbilityActivationFailure& OutFailure) const
+{
+	OutFailure = EGMCAbilityActivationFailure::None;
+	if (!AbilityClass)
+	{
+		OutFailure = EGMCAbilityActivationFailure::NotGranted;
+		return false;
+	}
+
+	const UGMCAbility* AbilityCDO = AbilityClass.GetDefaultObject();
+
+	if (!AbilityCDO->bAllowMultipleInstances && CountActiveAbilities(AbilityClass) > 0)
+	{
+		OutFailure = EGMCAbilityActivationFailure::AlreadyActive;
+	}
+	else if (!CheckActivationTags(AbilityCDO))
+	{
+		OutFailure = EGMCAbilityActivationFailure::BlockedByTag;
+		for (const FGameplayTag& Tag : AbilityCDO->ActivationRequiredTags)
 		{
-			for (auto& Tag : ActiveAbility.Value->BlockOtherAbility) {
-				if (AbilityTag.MatchesTag(Tag)) {
-					UE_LOG(LogGMCAbilitySystem, Verbose, TEXT("Ability can't activate, blocked by Ability: %s"), *ActiveAbility.Value->GetName());
-					return true;
-				}
+			if (!HasActiveTag(Tag))
+			{
+				OutFailure = EGMCAbilityActivationFailure::MissingRequiredTag;
+				break;
 			}
 		}
 	}
+	else if (GetCooldownForAbility(AbilityCDO->AbilityTag) > 0.f)
+	{
+		OutFailure = EGMCAbilityActivationFailure::Cooldown;
+	}
+	else if (RunningAbilityTags.HasAny(AbilityCDO->BlockedByOtherAbility) || IsAbilityTagBlocked(AbilityCDO->AbilityTag))
+	{
+		OutFailure = EGMCAbilityActivationFailure::BlockedByAbility;
+	}
+	else if (!AbilityCDO->CanAffordAbilityCostOn(this, 1.f))
+	{
+		OutFailure = EGMCAbilityActivationFailure::Cost;
+	}
+
+	return OutFailure == EGMCAbilityActivationFailure::None;
+}
+
+
+bool UGMC_AbilitySystemComponent::CanActivateAbilityByInputTag(FGameplayTag InputTag, EGMCAbilityActivationFailure& OutFailure) const
+{
+	OutFailure = EGMCAbilityActivationFailure::NotGranted;
+	if (!GrantedAbilityTags.HasTag(InputTag)) return false;
+
+	// Read the compiled table if there is one; building it would mean changing state.
+	TConstArrayView<TSubclassOf<UGMCAbility>> Abilities;
+	if (AbilityMapTable.IsValid())
+	{
+		Abilities = AbilityMapTable->Find(InputTag);
+	}
+	else if (const FAbilityMapData* MapEntry = AbilityMap.Find(InputTag))
+	{
+		Abilities = MapEntry->Abilities;
+	}
+
+	bool bFirst = true;
+	for (const TSubclassOf<UGMCAbility>& AbilityClass : Abilities)
+	{
+		EGMCAbilityActivationFailure Failure;
+		if (CanActivateAbility(AbilityClass, Failure))
+		{
+			OutFailure = EGMCAbilityActivationFailure::None;
+			return true;
+		}
+
+		if (bFirst)
+		{
+			OutFailure = Failure;
+			bFirst = false;
+		}
+	}
 
 	return false;
 }
 
 
+void UGMC_AbilitySystemComponent::AddActiveAbility(int32 AbilityID, UGMCAbility* Ability)
+{
+	ActiveAbilities.Add(AbilityID, Ability);
+
+	for (const FGameplayTag& Tag : Ability->AbilityTag.GetGameplayTagParents())
+	{
+		ActiveAbilityIdsByTag.FindOrAdd(Tag).Add(AbilityID);
+	}
+
+	for (const UClass* Class = Ability->GetClass(); Class; Class = Class->GetSuperClass())
+	{
+		ActiveAbilityIdsByClass.FindOrAdd(Class).Add(AbilityID);
+		if (Class == UGMCAbility::StaticClass()) break;
+	}
+}
+
+
+void UGMC_AbilitySystemComponent::RemoveActiveAbilityIndexes(int32 AbilityID, const UGMCAbility* Ability)
+{
+	for (const FGameplayTag& Tag : Ability->AbilityTag.GetGameplayTagParents())
+	{
+		if (TArray<int32>* AbilityIds = ActiveAbilityIdsByTag.Find(Tag))
+		{
+			AbilityIds->RemoveSingleSwap(AbilityID);
+			if (AbilityIds->IsEmpty()) ActiveAbilityIdsByTag.Remove(Tag);
+		}
+	}
+
+	for (const UClass* Class = Ability->GetClass(); Class; Class = Class->GetSuperClass())
+	{
+		if (TArray<int32>* AbilityIds = ActiveAbilityIdsByClass.Find(Class))
+		{
+			AbilityIds->RemoveSingleSwap(AbilityID);
+			if (AbilityIds->IsEmpty()) ActiveAbilityIdsByClass.Remove(Class);
+		}
+		if (Class == UGMCAbility::StaticClass()) break;
+	}
+}
+
+
+void UGMC_AbilitySystemComponent::GetActiveAbilityIdsByTag(FGameplayTag AbilityTag, TArray<int32, TInlineAllocator<8>>& OutAbilityIds) const
+{
+	OutAbilityIds.Reset();
+	if (const TArray<int32>* AbilityIds = ActiveAbilityIdsByTag.Find(AbilityTag))
+	{
+		OutAbilityIds.Append(*AbilityIds);
+	}
+}
+
+
+void UGMC_AbilitySystemComponent::GetActiveAbilityIdsByClass(TSubclassOf<UGMCAbility> AbilityClass, TArray<int32, TInlineAllocator<8>>& OutAbilityIds) const
+{
+	OutAbilityIds.Reset();
+	if (const TArray<int32>* AbilityIds = ActiveAbilityIdsByClass.Find(AbilityClass.Get()))
+	{
+		OutAbilityIds.Append(*AbilityIds);
+	}
+}
+
+
+bool UGMC_AbilitySystemComponent::IsAbilityTagBlocked(const FGameplayTag AbilityTag) const {
+	
+	if (AbilityTag.MatchesAny(BlockedAbilityTags)) {
+		UE_LOG(LogGMCAbilitySystem, Verbose, TEXT("Ability can't activate, %s blocked by running abilities (%s)"), *AbilityTag.ToString(), *BlockedAbilityTags.ToStringSimple());
+		return true;
+	}
+
+	return false;
+}
+
+namespace
+{
+	void AddTagCount(TMap<FGameplayTag, int32>& Counts, FGameplayTagContainer& Container, const FGameplayTag& Tag)
+	{
+		if (!Tag.IsValid()) return;
+
+		if (Counts.FindOrAdd(Tag)++ == 0)
+		{
+			Container.AddTagFast(Tag);
+		}
+	}
+
+	void RemoveTagCount(TMap<FGameplayTag, int32>& Counts, FGameplayTagContainer& Container, const FGameplayTag& Tag)
+	{
+		int32* Count = Counts.Find(Tag);
+		if (Count && --(*Count) <= 0)
+		{
+			Counts.Remove(Tag);
+			Container.RemoveTag(Tag);
+		}
+	}
+}
+
+void UGMC_AbilitySystemComponent::AddRunningAbilityTags(const UGMCAbility* Ability)
+{
+	AddTagCount(RunningAbilityTagCounts, RunningAbilityTags, Ability->AbilityTag);
+	for (const FGameplayTag& Tag : Ability->BlockOtherAbility)
+	{
+		AddTagCount(BlockedAbilityTagCounts, BlockedAbilityTags, Tag);
+	}
+}
+
+void UGMC_AbilitySystemComponent::RemoveRunningAbilityTags(const UGMCAbility* Ability)
+{
+	RemoveTagCount(RunningAbilityTagCounts, RunningAbilityTags, Ability->AbilityTag);
+	for (const FGameplayTag& Tag : Ability->BlockOtherAbility)
+	{
+		RemoveTagCount(BlockedAbilityTagCounts, BlockedAbilityTags, Tag);
+	}
+}
+
+
 int UGMC_AbilitySystemComponent::EndAbilitiesByTag(FGameplayTag AbilityTag) {
+	TArray<int32, TInlineAllocator<8>> AbilityIds;
+	GetActiveAbilityIdsByTag(AbilityTag, AbilityIds);
+
 	int AbilitiesEnded = 0;
-	for (const auto& ActiveAbilityData : ActiveAbilities)
+	for (const int32 AbilityID : AbilityIds)
 	{
-		if (ActiveAbilityData.Value->AbilityTag.MatchesTag(AbilityTag))
+		if (UGMCAbility** Ability = ActiveAbilities.Find(AbilityID))
 		{
-			ActiveAbilityData.Value->EndAbility();
+			(*Ability)->EndAbility();
 			AbilitiesEnded++;
 		}
 	}
@@ -439,12 +728,15 @@ int UGMC_AbilitySystemComponent::EndAbilitiesByTag(FGameplayTag AbilityTag) {
 
 
 int UGMC_AbilitySystemComponent::EndAbilitiesByClass(TSubclassOf<UGMCAbility> AbilityClass) {
+	TArray<int32, TInlineAllocator<8>> AbilityIds;
+	GetActiveAbilityIdsByClass(AbilityClass, AbilityIds);
+
 	int AbilitiesEnded = 0;
-	for (const auto& ActiveAbilityData : ActiveAbilities)
+	for (const int32 AbilityID : AbilityIds)
 	{
-		if (ActiveAbilityData.Value->IsA(AbilityClass))
+		if (UGMCAbility** Ability = ActiveAbilities.Find(AbilityID))
 		{
-			ActiveAbilityData.Value->EndAbility();
+			(*Ability)->EndAbility();
 			AbilitiesEnded++;
 		}
 	}
@@ -492,24 +784,84 @@ void UGMC_AbilitySystemComponent::QueueTaskData(const FInstancedStruct& InTaskDa
 void UGMC_AbilitySystemComponent::SetCooldownForAbility(const FGameplayTag AbilityTag, float CooldownTime)
 {
 	if (AbilityTag == FGameplayTag::EmptyTag) return;
-	
-	if (ActiveCooldowns.Contains(AbilityTag))
+
+	FGMCAbilityCooldown& Cooldown = WriteCooldown(AbilityTag);
+	Cooldown.RechargedAt = ActionTimer + CooldownTime;
+	Cooldown.RechargeTime = CooldownTime;
+	Cooldown.MaxCharges = 1;
+}
+
+void UGMC_AbilitySystemComponent::ConsumeChargeForAbility(const FGameplayTag AbilityTag, float RechargeTime, int32 MaxCharges)
+{
+	if (MaxCharges <= 1)
 	{
-		ActiveCooldowns[AbilityTag] = CooldownTime;
+		SetCooldownForAbility(AbilityTag, RechargeTime);
 		return;
 	}
-	ActiveCooldowns.Add(AbilityTag, CooldownTime);
+
+	if (AbilityTag == FGameplayTag::EmptyTag || RechargeTime <= 0.f) return;
+
+	FGMCAbilityCooldown& Cooldown = WriteCooldown(AbilityTag);
+	Cooldown.RechargedAt = FMath::Max(Cooldown.RechargedAt, ActionTimer) + RechargeTime;
+	Cooldown.RechargeTime = RechargeTime;
+	Cooldown.MaxCharges = MaxCharges;
 }
 
 float UGMC_AbilitySystemComponent::GetCooldownForAbility(const FGameplayTag AbilityTag) const
 {
-	if (ActiveCooldowns.Contains(AbilityTag))
+	if (const FGMCAbilityCooldown* Cooldown = FindCooldown(AbilityTag))
 	{
-		return ActiveCooldowns[AbilityTag];
+		return Cooldown->GetRemainingTime(ActionTimer);
 	}
 	return 0.f;
 }
 
+int32 UGMC_AbilitySystemComponent::GetChargesForAbility(TSubclassOf<UGMCAbility> Ability) const
+{
+	if (!Ability) return 0;
+
+	const UGMCAbility* AbilityCDO = Ability.GetDefaultObject();
+	if (const FGMCAbilityCooldown* Cooldown = FindCooldown(AbilityCDO->AbilityTag))
+	{
+		return Cooldown->GetCharges(ActionTimer);
+	}
+	return FMath::Max(AbilityCDO->MaxCharges, 1);
+}
+
+FGMCAbilityCooldown* UGMC_AbilitySystemComponent::FindCooldown(const FGameplayTag& AbilityTag)
+{
+	return CooldownData.GetMutable<FGMCAbilityCooldownData>().Cooldowns.FindByPredicate([&AbilityTag](const FGMCAbilityCooldown& Cooldown)
+	{
+		return Cooldown.AbilityTag == AbilityTag;
+	});
+}
+
+const FGMCAbilityCooldown* UGMC_AbilitySystemComponent::FindCooldown(const FGameplayTag& AbilityTag) const
+{
+	return CooldownData.Get<FGMCAbilityCooldownData>().Cooldowns.FindByPredicate([&AbilityTag](const FGMCAbilityCooldown& Cooldown)
+	{
+		return Cooldown.AbilityTag == AbilityTag;
+	});
+}
+
+FGMCAbilityCooldown& UGMC_AbilitySystemComponent::WriteCooldown(const FGameplayTag& AbilityTag)
+{
+	TArray<FGMCAbilityCooldown>& Cooldowns = CooldownData.GetMutable<FGMCAbilityCooldownData>().Cooldowns;
+	Cooldowns.RemoveAllSwap([this, &AbilityTag](const FGMCAbilityCooldown& Cooldown)
+	{
+		return Cooldown.AbilityTag != AbilityTag && Cooldown.RechargedAt <= ActionTimer;
+	});
+
+	if (FGMCAbilityCooldown* Existing = FindCooldown(AbilityTag))
+	{
+		return *Existing;
+	}
+
+	FGMCAbilityCooldown& Cooldown = Cooldowns.AddDefaulted_GetRef();
+	Cooldown.AbilityTag = AbilityTag;
+	return Cooldown;
+}
+
 
 float UGMC_AbilitySystemComponent::GetMaxCooldownForAbility(TSubclassOf<UGMCAbility> Ability) const {
 	return Ability ? Ability.GetDefaultObject()->CooldownTime : 0.f;
@@ -518,11 +870,9 @@ float UGMC_AbilitySystemComponent::GetMaxCooldownForAbility(TSubclassOf<UGMCAbil
 
 TMap<FGameplayTag, float> UGMC_AbilitySystemComponent::GetCooldownsForInputTag(const FGameplayTag InputTag)
 {
-	TArray<TSubclassOf<UGMCAbility>> Abilities = GetGrantedAbilitiesByTag(InputTag);
-
 	TMap<FGameplayTag, float> Cooldowns;
 
-	for (auto Ability : Abilities)
+	for (const TSubclassOf<UGMCAbility>& Ability : GetGrantedAbilitiesByTag(InputTag))
 	{
 		FGameplayTag AbilityTag = Ability.GetDefaultObject()->AbilityTag;
 		Cooldowns.Add(AbilityTag, GetCooldownForAbility(AbilityTag));
@@ -555,6 +905,13 @@ void UGMC_AbilitySystemComponent::GenPredictionTick(float DeltaTime)
 	bJustTeleported = false;
 	// ActionTimer += DeltaTime;
 	ActionTimer = GMCMovementComponent->GetMoveTimestamp();
+
+	// The client tells us with each move whether its class registry matches ours.
+	if (HasAuthority()) UpdateClassRegistryPeerMatch();
+
+	bInPredictionTick = true;
+
+	BeginBoundAbilityStateMove(GMCMovementComponent->CL_IsReplaying());
 	
 	ApplyStartingEffects();
 
@@ -582,16 +939,19 @@ void UGMC_AbilitySystemComponent::GenPredictionTick(float DeltaTime)
 	QueuedEffectOperations.GenPredictionTick(DeltaTime);
 	QueuedEventOperations.GenPredictionTick(DeltaTime);
 	
-	// Was an ability used?
-	if (TGMASBoundQueueOperation<UGMCAbility, FGMCAbilityData> Operation;
-		QueuedAbilityOperations.GetCurrentBoundOperation(Operation, true))
+	// Inputs buffered on earlier moves go first, as they were pressed first.
+	ProcessBufferedAbilityInputs();
+	
+	// Were any abilities used?
+	TGMASBoundQueueOperation<UGMCAbility, FGMCAbilityData> Operation;
+	for (int32 Idx = 0; QueuedAbilityOperations.GetCurrentBoundOperation(Idx, Operation); Idx++)
 	{
 		ProcessAbilityOperation(Operation, true);
 	}
 
 	ServerHandlePredictedPendingEffect(DeltaTime);
-	
-	
+
+	bInPredictionTick = false;
 }
 
 void UGMC_AbilitySystemComponent::GenSimulationTick(float DeltaTime)
@@ -625,7 +985,7 @@ void UGMC_AbilitySystemComponent::PreLocalMoveExecution()
 	QueuedAbilityOperations.PreLocalMovement();
 	QueuedEffectOperations_ClientAuth.PreLocalMovement();
 
-	if (GetNetMode() == NM_Standalone || GMCMovementComponent->IsLocallyControlledServerPawn())
+	if (IsAuthorityOnly() || GMCMovementComponent->IsLocallyControlledServerPawn())
 	{
 		// We'll never get the pre remote movement trigger in this case, soooo...
 		QueuedEffectOperations.PreRemoteMovement();
@@ -647,6 +1007,78 @@ void UGMC_AbilitySystemComponent::BeginPlay()
 	InitializeStartingAbilities();
 	InitializeAbilityMap();
 	SetStartingTags();
+	BuildClassRegistry();
+}
+
+void UGMC_AbilitySystemComponent::BuildClassRegistry()
+{
+	// Only use our defaults here, never runtime state, so that every machine builds the same registry.
+	TArray<FSoftObjectPath> ClassPaths;
+	auto AddEffectClass = [&ClassPaths](const TSubclassOf<UGMCAbilityEffect>& EffectClass)
+	{
+		if (EffectClass) ClassPaths.Add(FSoftObjectPath(EffectClass.Get()));
+	};
+
+	for (const UGMCAbilityMapData* StartingAbilityMap : AbilityMaps)
+	{
+		if (!StartingAbilityMap) continue;
+
+		for (const FAbilityMapData& Data : StartingAbilityMap->GetAbilityMapData())
+		{
+			for (const TSubclassOf<UGMCAbility>& AbilityClass : Data.Abilities)
+			{
+				if (!AbilityClass) continue;
+
+				// Ability map entries are hard references, so the class and its defaults were loaded along with the
+				// map; this never loads anything itself.
+				ClassPaths.Add(FSoftObjectPath(AbilityClass.Get()));
+				AddEffectClass(AbilityClass->GetDefaultObject<UGMCAbility>()->AbilityCost);
+			}
+		}
+	}
+
+	for (const TSubclassOf<UGMCAbilityEffect>& EffectClass : StartingEffects)
+	{
+		AddEffectClass(EffectClass);
+	}
+
+	ClassRegistry.Build(MoveTemp(ClassPaths));
+
+	if (HasAuthority())
+	{
+		ServerClassRegistryHash = ClassRegistry.GetHash();
+
+		// Our own input on a listen server; a remote client's moves overwrite it.
+		bClassRegistryMatchesServer = true;
+	}
+	UpdateClassRegistryPeerMatch();
+}
+
+void UGMC_AbilitySystemComponent::OnRep_ServerClassRegistryHash()
+{
+	// Before BeginPlay our own registry isn't built yet; BuildClassRegistry checks it then.
+	if (HasBegunPlay()) UpdateClassRegistryPeerMatch();
+}
+
+void UGMC_AbilitySystemComponent::UpdateClassRegistryPeerMatch()
+{
+	if (IsAuthorityOnly())
+	{
+		// Operations never leave this machine.
+		ClassRegistry.SetPeerMatches(true);
+		return;
+	}
+
+	if (!HasAuthority())
+	{
+		bClassRegistryMatchesServer = ServerClassRegistryHash == ClassRegistry.GetHash();
+		if (!bClassRegistryMatchesServer && ServerClassRegistryHash != 0)
+		{
+			UE_LOG(LogGMCAbilitySystem, Warning, TEXT("[%20s] %s class registry differs from the server's; queued operation classes will be sent by path."),
+				*GetNetRoleAsString(GetOwnerRole()), *GetOwner()->GetName())
+		}
+	}
+	ClassRegistry.SetPeerMatches(bClassRegistryMatchesServer);
 }
 
 void UGMC_AbilitySystemComponent::InstantiateAttributes()
@@ -774,21 +1206,77 @@ void UGMC_AbilitySystemComponent::CheckAttributeChanged() {
 }
 
 
-void UGMC_AbilitySystemComponent::CleanupStaleAbilities()
+void UGMC_AbilitySystemComponent::CleanupStaleAbilities()
+{
+	for (auto It = ActiveAbilities.CreateIterator(); It; ++It)
+	{
+		// If the contained ability is in the Ended state, delete it
+		if (It.Value()->AbilityState == EAbilityState::Ended)
+		{
+			// Only ends of abilities the server also activated are recorded, so a refused activation isn't corrected twice.
+			if (!GetBoundAbilityState().WasActivationRefused(It.Key()))
+			{
+				GetWritableBoundAbilityState().EndedAbilities.Add(It.Key(), FGMASIdAllocator::GetSeed(ActionTimer));
+			}
+			UGMCAbility* EndedAbility = It.Value();
+			OutsideMoveActivations.Remove(It.Key());
+			RemoveActiveAbilityIndexes(It.Key(), EndedAbility);
+			It.RemoveCurrent();
+			ReleaseAbilityInstance(EndedAbility);
+		}
+	}
+}
+
+UGMCAbility* UGMC_AbilitySystemComponent::AcquireAbilityInstance(TSubclassOf<UGMCAbility> AbilityClass)
+{
+	if (!AbilityClass->GetDefaultObject<UGMCAbility>()->bPoolInstances)
+	{
+		return NewObject<UGMCAbility>(this, AbilityClass);
+	}
+
+	FGMCAbilityPool& Pool = AbilityPools.FindOrAdd(AbilityClass);
+	while (Pool.Instances.Num() > 0)
+	{
+#if ENGINE_MAJOR_VERSION >=5 && ENGINE_MINOR_VERSION >= 4
+		UGMCAbility* Ability = Pool.Instances.Pop(EAllowShrinking::No);
+#else
+		UGMCAbility* Ability = Pool.Instances.Pop(false);
+#endif
+		if (IsValid(Ability))
+		{
+			Pool.Stats.NumReused++;
+			return Ability;
+		}
+	}
+
+	Pool.Stats.NumCreated++;
+	return NewObject<UGMCAbility>(this, AbilityClass);
+}
+
+void UGMC_AbilitySystemComponent::ReleaseAbilityInstance(UGMCAbility* Ability)
+{
+	if (!IsValid(Ability) || !Ability->bPoolInstances) return;
+
+	FGMCAbilityPool& Pool = AbilityPools.FindOrAdd(Ability->GetClass());
+	if (Pool.Instances.Num() >= MaxPooledAbilitiesPerClass)
+	{
+		Pool.Stats.NumDiscarded++;
+		return;
+	}
+
+	// Reset now rather than on reuse, so pooled instances don't keep their last activation's references alive.
+	Ability->ResetAbility();
+	Pool.Instances.Add(Ability);
+}
+
+FGMCAbilityPoolStats UGMC_AbilitySystemComponent::GetAbilityPoolStats(TSubclassOf<UGMCAbility> AbilityClass) const
 {
-	for (auto It = ActiveAbilities.CreateIterator(); It; ++It)
-	{
-		// If the contained ability is in the Ended state, delete it
-		if (It.Value()->AbilityState == EAbilityState::Ended)
-		{
-			if (HasAuthority() && !GMCMovementComponent->IsLocallyControlledServerPawn())
-			{
-				// Fail safe to tell client server has ended the ability
-				RPCClientEndAbility(It.Value()->GetAbilityID());
-			};
-			It.RemoveCurrent();
-		}
-	}
+	const FGMCAbilityPool* Pool = AbilityPools.Find(AbilityClass);
+	if (!Pool) return FGMCAbilityPoolStats();
+
+	FGMCAbilityPoolStats Stats = Pool->Stats;
+	Stats.NumPooled = Pool->Instances.Num();
+	return Stats;
 }
 
 void UGMC_AbilitySystemComponent::TickActiveEffects(float DeltaTime)
@@ -815,7 +1303,7 @@ void UGMC_AbilitySystemComponent::TickActiveEffects(float DeltaTime)
 
 		// Check for predicted effects that have not been server confirmed
 		if (!HasAuthority() &&
-			!Effect.Value->EffectData.bServerAuth
+			!Effect.Value->IsServerAuth()
 			&& ProcessedEffectIDs.Contains(Effect.Key) 
 			&& ProcessedEffectIDs[Effect.Key] == EGMCEffectAnswerState::Pending
 			&& Effect.Value->ClientEffectApplicationTime + ClientEffectApplicationTimeout < ActionTimer)
@@ -830,11 +1318,15 @@ void UGMC_AbilitySystemComponent::TickActiveEffects(float DeltaTime)
 	// Clean expired effects
 	for (const int EffectID : CompletedActiveEffects)
 	{
-		// Notify client. Redundant.
-		if (HasAuthority()) {RPCClientEndEffect(EffectID);}
+		// Effects the server never confirmed aren't recorded, since it never had them.
+		const EGMCEffectAnswerState* AnswerState = ProcessedEffectIDs.Find(EffectID);
+		if (!AnswerState || *AnswerState != EGMCEffectAnswerState::Timeout)
+		{
+			GetWritableBoundAbilityState().EndedEffects.Add(EffectID, FGMASIdAllocator::GetSeed(ActionTimer));
+		}
 		
 		ActiveEffects.Remove(EffectID);
-		ActiveEffectsData.RemoveAll([EffectID](const FGMCAbilityEffectData& EffectData) {return EffectData.EffectID == EffectID;});
+		ActiveEffectsData.RemoveAll([EffectID](const FGMCAbilityEffectInstanceData& EffectData) {return EffectData.EffectID == EffectID;});
 	}
 
 	// Clean effect handles
@@ -845,7 +1337,7 @@ void UGMC_AbilitySystemComponent::TickActiveEffects(float DeltaTime)
 		const auto& Data = EffectHandles[Handle];
 		if (Data.NetworkId > 0 && !ActiveEffects.Contains(Data.NetworkId))
 		{
-			EffectHandles.Remove(Handle);
+			RemoveEffectHandle(Handle);
 		}
 	}
 	
@@ -885,32 +1377,22 @@ void UGMC_AbilitySystemComponent::TickAncillaryActiveAbilities(float DeltaTime){
 	}
 }
 
-void UGMC_AbilitySystemComponent::TickActiveCooldowns(float DeltaTime)
-{
-	for (auto It = ActiveCooldowns.CreateIterator(); It; ++It)
-	{
-		It.Value() -= DeltaTime;
-		if (It.Value() <= 0)
-		{
-			It.RemoveCurrent();
-		}
-	}
-}
-
 void UGMC_AbilitySystemComponent::OnRep_ActiveEffectsData()
 {
-	for (FGMCAbilityEffectData ActiveEffectData : ActiveEffectsData)
+	for (const FGMCAbilityEffectInstanceData& ActiveEffectData : ActiveEffectsData)
 	{
 		if (ActiveEffectData.EffectID == 0) continue;
 		
 		if (!ProcessedEffectIDs.Contains(ActiveEffectData.EffectID) || ProcessedEffectIDs[ActiveEffectData.EffectID] == EGMCEffectAnswerState::Timeout)
 		{
-			// The client never predicted this effect, so we process it as a new effect.
-			UGMCAbilityEffect* EffectCDO = DuplicateObject(UGMCAbilityEffect::StaticClass()->GetDefaultObject<UGMCAbilityEffect>(), this);
+			// The client never predicted this effect, so we process it as a new effect. Any definition overrides the
+			// server applied it with come along in the instance data.
+			const TSubclassOf<UGMCAbilityEffect> EffectClass = ActiveEffectData.EffectClass ? ActiveEffectData.EffectClass : TSubclassOf<UGMCAbilityEffect>(UGMCAbilityEffect::StaticClass());
+			UGMCAbilityEffect* Effect = NewObject<UGMCAbilityEffect>(this, EffectClass);
 
-			ApplyAbilityEffect(EffectCDO, ActiveEffectData);
+			ApplyAbilityEffect(Effect, ActiveEffectData);
 			ProcessedEffectIDs.Add(ActiveEffectData.EffectID, EGMCEffectAnswerState::Validated);
-			UE_LOG(LogGMCAbilitySystem, Warning, TEXT("[Client] Effect [%d] %s has been force apply by the server"), ActiveEffectData.EffectID, *ActiveEffectData.EffectTag.ToString());
+			UE_LOG(LogGMCAbilitySystem, Warning, TEXT("[Client] Effect [%d] %s has been force apply by the server"), ActiveEffectData.EffectID, *Effect->GetDefinition().EffectTag.ToString());
 		}
 		
 		ProcessedEffectIDs[ActiveEffectData.EffectID] = EGMCEffectAnswerState::Validated;
@@ -928,7 +1410,7 @@ void UGMC_AbilitySystemComponent::CheckRemovedEffects()
 		// it means the server removed it
 		if (ProcessedEffectIDs[Effect.Key] == EGMCEffectAnswerState::Pending){return;}
 		
-		if (!ActiveEffectsData.ContainsByPredicate([Effect](const FGMCAbilityEffectData& EffectData) {return EffectData.EffectID == Effect.Key;}))
+		if (!ActiveEffectsData.ContainsByPredicate([Effect](const FGMCAbilityEffectInstanceData& EffectData) {return EffectData.EffectID == Effect.Key;}))
 		{
 			RemoveActiveAbilityEffect(Effect.Value);
 		}
@@ -944,27 +1426,39 @@ void UGMC_AbilitySystemComponent::ServerHandlePendingEffect(float DeltaTime) {
 	// the message server-to-client via GMC, but we *can* preserve it in the move history in
 	// case it is relevant to replay.
 	TGMASBoundQueueOperation<UGMCAbilityEffect, FGMCAbilityEffectData> BoundOperation;
-	if (QueuedEffectOperations.GetCurrentBoundOperation(BoundOperation, true))
+	for (int32 Idx = 0; QueuedEffectOperations.GetCurrentBoundOperation(Idx, BoundOperation); Idx++)
 	{
 		// Move this into our RPC queue to wait on acknowledgment.
 		QueuedEffectOperations.QueuePreparedOperation(BoundOperation, false);
 
 		// And send it via RPC, so that the client gets it.
 		ClientQueueOperation(BoundOperation);
-	};
+	}
 
-	// Handle our 'outer' RPC effect operations.
-	QueuedEffectOperations.DeductGracePeriod(DeltaTime);
-	auto Operations = QueuedEffectOperations.GetQueuedRPCOperations();
-	for (auto& Operation : Operations) {
-		if (ShouldProcessOperation(Operation, QueuedEffectOperations, true))
+	// Handle our 'outer' RPC effect operations. Only those the client acknowledged or which ran out of grace period
+	// need looking at, unless there's no client to wait on.
+	QueuedEffectOperations.AdvanceGraceClock(DeltaTime);
+	// Processing an operation can queue others, so walk a snapshot of the IDs and only copy the operations we process.
+	TArray<int32, TInlineAllocator<16>> OperationIds;
+	if (IsAuthorityOnly())
+	{
+		QueuedEffectOperations.GetQueuedRPCOperationIds(OperationIds);
+	}
+	else
+	{
+		QueuedEffectOperations.GetDueRPCOperationIds(OperationIds);
+	}
+	for (const int32 OperationId : OperationIds) {
+		const auto* QueuedOperation = QueuedEffectOperations.FindOperationById(OperationId);
+		if (QueuedOperation && ShouldProcessOperation(*QueuedOperation, QueuedEffectOperations, true))
 		{
-			if (Operation.GracePeriodExpired())
+			if (QueuedEffectOperations.IsGracePeriodExpired(*QueuedOperation))
 			{
 				UE_LOG(LogGMCAbilitySystem, Warning, TEXT("Client effect operation missed grace period, forcing on server."))
 			}
+			auto Operation = *QueuedOperation;
 			ProcessOperation(Operation);
-			QueuedEffectOperations.RemoveOperationById(Operation.GetOperationId());
+			QueuedEffectOperations.RemoveOperationById(OperationId);
 		}
 	}
 }
@@ -975,7 +1469,7 @@ void UGMC_AbilitySystemComponent::ServerHandlePredictedPendingEffect(float Delta
 	
 	// Check for any client-auth effects.
 	TGMASBoundQueueOperation<UGMCAbilityEffect, FGMCAbilityEffectData> BoundOperation;
-	if (QueuedEffectOperations_ClientAuth.GetCurrentBoundOperation(BoundOperation, true))
+	for (int32 Idx = 0; QueuedEffectOperations_ClientAuth.GetCurrentBoundOperation(Idx, BoundOperation); Idx++)
 	{
 		ProcessOperation(BoundOperation);
 	}
@@ -994,16 +1488,22 @@ void UGMC_AbilitySystemComponent::ClientHandlePendingOperation(TGMASBoundQueue<C
 
 // Handle our RPC effect operations. MoveCycle operations will be sent via RPC
     // just like the Outer ones, but will be preserved in the movement history.
-    auto RPCOperations = QueuedOperations.GetQueuedRPCOperations();
-    for (auto& Operation : RPCOperations) {
-        if (QueuedOperations.IsAcknowledged(Operation.GetOperationId()))
+    TArray<int32, TInlineAllocator<16>> OperationIds;
+    QueuedOperations.GetQueuedRPCOperationIds(OperationIds);
+    for (const int32 OperationId : OperationIds) {
+        const auto* QueuedOperation = QueuedOperations.FindOperationById(OperationId);
+        if (!QueuedOperation) continue;
+
+        if (QueuedOperations.IsAcknowledged(OperationId))
         {
+            auto Operation = *QueuedOperation;
             ProcessOperation(Operation);
-            QueuedOperations.RemoveOperationById(Operation.GetOperationId());
+            QueuedOperations.RemoveOperationById(OperationId);
+            continue;
         }
-        if (ShouldProcessOperation(Operation, QueuedOperations, false))
+        if (ShouldProcessOperation(*QueuedOperation, QueuedOperations, false))
         {
-            QueuedOperations.Acknowledge(Operation.GetOperationId());
+            QueuedOperations.Acknowledge(OperationId);
         }
     }
 }
@@ -1011,7 +1511,7 @@ void UGMC_AbilitySystemComponent::ClientHandlePendingOperation(TGMASBoundQueue<C
 void UGMC_AbilitySystemComponent::ClientHandlePredictedPendingEffect()
 {
 	TGMASBoundQueueOperation<UGMCAbilityEffect, FGMCAbilityEffectData> BoundOperation;
-	if (QueuedEffectOperations_ClientAuth.GetCurrentBoundOperation(BoundOperation))
+	for (int32 Idx = 0; QueuedEffectOperations_ClientAuth.GetCurrentBoundOperation(Idx, BoundOperation); Idx++)
 	{
 		ProcessOperation(BoundOperation);
 	}	
@@ -1033,38 +1533,88 @@ bool UGMC_AbilitySystemComponent::IsLocallyControlledPawnASC() const
 	return false;
 }
 
-void UGMC_AbilitySystemComponent::RPCClientEndEffect_Implementation(int EffectID)
+void UGMC_AbilitySystemComponent::BeginBoundAbilityStateMove(bool bReplaying)
 {
-	if (ActiveEffects.Contains(EffectID))
+	FGMCBoundAbilityState& State = GetBoundAbilityState();
+	State.Expire(ActionTimer);
+
+	const int32 EndedAt = FGMASIdAllocator::GetSeed(ActionTimer);
+	if (bReplaying)
+	{
+		// A correction to an earlier move drops whatever this move took from the pending state.
+		for (const TPair<double, FGMCBoundAbilityState>& Appended : AppendedPendingStates)
+		{
+			if (Appended.Key == ActionTimer)
+			{
+				State.Append(Appended.Value, EndedAt);
+			}
+		}
+		return;
+	}
+
+	AppendedPendingStates.RemoveAll([this](const TPair<double, FGMCBoundAbilityState>& Appended)
+	{
+		return Appended.Key < ActionTimer - FGMCBoundAbilityState::LifetimeSeconds;
+	});
+
+	// Whatever was recorded since the last move becomes part of this one.
+	if (!PendingBoundAbilityState.IsEmpty())
 	{
-		ActiveEffects[EffectID]->EndEffect();
-		UE_LOG(LogGMCAbilitySystem, VeryVerbose, TEXT("[RPC] Server Ended Effect: %d"), EffectID);
+		State.Append(PendingBoundAbilityState, EndedAt);
+		AppendedPendingStates.Emplace(ActionTimer, MoveTemp(PendingBoundAbilityState));
+		PendingBoundAbilityState.Reset();
 	}
 }
 
-void UGMC_AbilitySystemComponent::RPCTaskHeartbeat_Implementation(int AbilityID, int TaskID)
+void UGMC_AbilitySystemComponent::ReconcileBoundAbilityState()
 {
-	if (ActiveAbilities.Contains(AbilityID) && ActiveAbilities[AbilityID] != nullptr)
+	if (HasAuthority()) return;
+
+	const FGMCBoundAbilityState& State = BoundAbilityState.Get<FGMCBoundAbilityState>();
+
+	for (const TPair<int, UGMCAbility*>& ActiveAbility : ActiveAbilities)
 	{
-		ActiveAbilities[AbilityID]->HandleTaskHeartbeat(TaskID);
+		UGMCAbility* Ability = ActiveAbility.Value;
+		if (!Ability || Ability->AbilityState == EAbilityState::Ended) continue;
+
+		if (State.EndedAbilities.Contains(ActiveAbility.Key))
+		{
+			UE_LOG(LogGMCAbilitySystem, VeryVerbose, TEXT("Server Ended Ability: %d"), ActiveAbility.Key);
+			Ability->EndAbility();
+		}
+		else if (State.WasActivationRefused(ActiveAbility.Key))
+		{
+			// Give the server time to put an activation made outside a move on a move of its own.
+			const double* ActivatedAt = OutsideMoveActivations.Find(ActiveAbility.Key);
+			if (ActivatedAt && ActionTimer < *ActivatedAt + OutsideMoveConfirmTimeout) continue;
+
+			UE_LOG(LogGMCAbilitySystem, Error, TEXT("Ability Not Confirmed By Server: %d, Removing..."), ActiveAbility.Key);
+			Ability->EndAbility();
+		}
 	}
-}
 
-void UGMC_AbilitySystemComponent::RPCClientEndAbility_Implementation(int AbilityID)
-{
-	if (ActiveAbilities.Contains(AbilityID))
+	if (State.EndedEffects.IsEmpty()) return;
+
+	TArray<UGMCAbilityEffect*, TInlineAllocator<8>> EffectsToEnd;
+	for (const TPair<int, UGMCAbilityEffect*>& Effect : ActiveEffects)
+	{
+		if (Effect.Value && !Effect.Value->bCompleted && State.EndedEffects.Contains(Effect.Key))
+		{
+			EffectsToEnd.Add(Effect.Value);
+		}
+	}
+	for (UGMCAbilityEffect* Effect : EffectsToEnd)
 	{
-		ActiveAbilities[AbilityID]->EndAbility();
-		UE_LOG(LogGMCAbilitySystem, VeryVerbose, TEXT("[RPC] Server Ended Ability: %d"), AbilityID);
+		UE_LOG(LogGMCAbilitySystem, VeryVerbose, TEXT("Server Ended Effect: %d"), Effect->GetEffectID());
+		Effect->EndEffect();
 	}
 }
 
-void UGMC_AbilitySystemComponent::RPCConfirmAbilityActivation_Implementation(int AbilityID)
+void UGMC_AbilitySystemComponent::RPCTaskHeartbeat_Implementation(int AbilityID, int TaskID)
 {
-	if (ActiveAbilities.Contains(AbilityID))
+	if (ActiveAbilities.Contains(AbilityID) && ActiveAbilities[AbilityID] != nullptr)
 	{
-		ActiveAbilities[AbilityID]->ServerConfirm();
-		UE_LOG(LogGMCAbilitySystem, VeryVerbose, TEXT("[RPC] Server Confirmed Long-Running Ability Activation: %d"), AbilityID);
+		ActiveAbilities[AbilityID]->HandleTaskHeartbeat(TaskID);
 	}
 }
 
@@ -1086,7 +1636,7 @@ void UGMC_AbilitySystemComponent::ApplyStartingEffects(bool bForce) {
 }
 
 
-TArray<TSubclassOf<UGMCAbility>> UGMC_AbilitySystemComponent::GetGrantedAbilitiesByTag(FGameplayTag AbilityTag)
+TConstArrayView<TSubclassOf<UGMCAbility>> UGMC_AbilitySystemComponent::GetGrantedAbilitiesByTag(FGameplayTag AbilityTag)
 {
 	if (!GrantedAbilityTags.HasTag(AbilityTag))
 	{
@@ -1094,13 +1644,24 @@ TArray<TSubclassOf<UGMCAbility>> UGMC_AbilitySystemComponent::GetGrantedAbilitie
 		return {};
 	}
 
-	if (!AbilityMap.Contains(AbilityTag))
+	const TSharedRef<const FGMCAbilityMapTable> Table = GetAbilityMapTable();
+	if (!Table->Contains(AbilityTag))
 	{
 		UE_LOG(LogGMCAbilitySystem, Warning, TEXT("Ability Tag Not Found: %s | Check The Component's AbilityMap"), *AbilityTag.ToString());
 		return {};
 	}
 
-	return AbilityMap[AbilityTag].Abilities;
+	// AbilityMapTable holds the table, so the view outlives our local reference.
+	return Table->Find(AbilityTag);
+}
+
+TSharedRef<const FGMCAbilityMapTable> UGMC_AbilitySystemComponent::GetAbilityMapTable()
+{
+	if (!AbilityMapTable.IsValid())
+	{
+		AbilityMapTable = FGMCAbilityMapTable::Build(AbilityMap);
+	}
+	return AbilityMapTable.ToSharedRef();
 }
 
 
@@ -1173,6 +1734,7 @@ void UGMC_AbilitySystemComponent::ClearAbilityMap()
 	}
 	
 	AbilityMap.Empty();
+	AbilityMapTable.Reset();
 }
 
 void UGMC_AbilitySystemComponent::SetAttributeInitialValue(const FGameplayTag& AttributeTag, float& BaseValue)
@@ -1181,6 +1743,8 @@ void UGMC_AbilitySystemComponent::SetAttributeInitialValue(const FGameplayTag& A
 }
 
 void UGMC_AbilitySystemComponent::InitializeAbilityMap(){
+	const bool bBuiltFromAssetsOnly = AbilityMap.IsEmpty();
+	
 	for (UGMCAbilityMapData* StartingAbilityMap : AbilityMaps)
 	{
 
@@ -1192,6 +1756,12 @@ void UGMC_AbilitySystemComponent::InitializeAbilityMap(){
 			AddAbilityMapData(Data);
 		}
 	}
+
+	// If nothing else has touched the map, share a table with every other component using these assets.
+	if (bBuiltFromAssetsOnly && AbilityMap.Num() > 0)
+	{
+		AbilityMapTable = FGMCAbilityMapTable::GetShared(AbilityMaps, AbilityMap);
+	}
 }
 
 void UGMC_AbilitySystemComponent::AddAbilityMapData(const FAbilityMapData& AbilityMapData)
@@ -1204,6 +1774,7 @@ void UGMC_AbilitySystemComponent::AddAbilityMapData(const FAbilityMapData& Abili
 	{
 		AbilityMap.Add(AbilityMapData.InputTag, AbilityMapData);
 	}
+	AbilityMapTable.Reset();
 	
 	if (AbilityMapData.bGrantedByDefault)
 	{
@@ -1216,6 +1787,7 @@ void UGMC_AbilitySystemComponent::RemoveAbilityMapData(const FAbilityMapData& Ab
 	if (AbilityMap.Contains(AbilityMapData.InputTag))
 	{
 		AbilityMap.Remove(AbilityMapData.InputTag);
+		AbilityMapTable.Reset();
 	}
 	
 	if (GrantedAbilityTags.HasTag(AbilityMapData.InputTag))
@@ -1239,7 +1811,11 @@ bool UGMC_AbilitySystemComponent::ProcessAbilityOperation(
 	EGMASBoundQueueOperationType OperationType = Operation.GetOperationType();
 	if (OperationType == EGMASBoundQueueOperationType::Activate)
 	{
-		TryActivateAbilitiesByInputTag(Operation.GetTag(), Operation.Payload.ActionInput, bFromMovementTick);
+		if (!TryActivateAbilitiesByInputTag(Operation.GetTag(), Operation.Payload.ActionInput, bFromMovementTick) && bFromMovementTick
+			&& IsAbilityInputTemporarilyBlocked(Operation.GetTag()))
+		{
+			BufferAbilityInput(Operation.GetTag(), Operation.Payload.ActionInput);
+		}
 		return true;
 	}
 
@@ -1258,6 +1834,58 @@ bool UGMC_AbilitySystemComponent::ProcessAbilityOperation(
 	return false;
 }
 
+void UGMC_AbilitySystemComponent::BufferAbilityInput(const FGameplayTag& InputTag, const UInputAction* InputAction)
+{
+	if (AbilityInputBufferTime <= 0.f) return;
+
+	TArray<FGMCBufferedAbilityInput>& Inputs = AbilityInputBuffer.GetMutable<FGMCAbilityInputBuffer>().Inputs;
+	FGMCBufferedAbilityInput* Input = Inputs.FindByPredicate([&InputTag](const FGMCBufferedAbilityInput& Buffered)
+	{
+		return Buffered.InputTag == InputTag;
+	});
+	if (!Input)
+	{
+		Input = &Inputs.AddDefaulted_GetRef();
+		Input->InputTag = InputTag;
+	}
+
+	Input->InputAction = InputAction;
+	Input->ExpiresAt = ActionTimer + AbilityInputBufferTime;
+}
+
+void UGMC_AbilitySystemComponent::ProcessBufferedAbilityInputs()
+{
+	TArray<FGMCBufferedAbilityInput>& Inputs = AbilityInputBuffer.GetMutable<FGMCAbilityInputBuffer>().Inputs;
+	if (Inputs.IsEmpty()) return;
+
+	// Retry from a copy, keeping only the inputs that still activate nothing.
+	const TArray<FGMCBufferedAbilityInput, TInlineAllocator<4>> Buffered(Inputs);
+	Inputs.Reset();
+
+	for (const FGMCBufferedAbilityInput& Input : Buffered)
+	{
+		if (Input.ExpiresAt < ActionTimer) continue;
+
+		if (!TryActivateAbilitiesByInputTag(Input.InputTag, Input.InputAction, true) && IsAbilityInputTemporarilyBlocked(Input.InputTag))
+		{
+			Inputs.Add(Input);
+		}
+	}
+}
+
+bool UGMC_AbilitySystemComponent::IsAbilityInputTemporarilyBlocked(const FGameplayTag& InputTag)
+{
+	for (const TSubclassOf<UGMCAbility>& AbilityClass : GetGrantedAbilitiesByTag(InputTag))
+	{
+		const UGMCAbility* AbilityCDO = AbilityClass->GetDefaultObject<UGMCAbility>();
+		if (AbilityCDO && AbilityCDO->bActivateOnMovementTick && AbilityCDO->IsActivationTemporarilyBlocked(this))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
 UGMCAbilityEffect* UGMC_AbilitySystemComponent::ProcessOperation(
 	const TGMASBoundQueueOperation<UGMCAbilityEffect, FGMCAbilityEffectData>& Operation)
 {
@@ -1269,37 +1897,40 @@ UGMCAbilityEffect* UGMC_AbilitySystemComponent::ProcessOperation(
 		{
 			UE_LOG(LogGMCAbilitySystem, Error, TEXT("[%20s] %s attempted to process an add effect operation with no set class!"),
 				*GetNetRoleAsString(GetOwnerRole()), *GetOwner()->GetName())
+			return nullptr;
 		}
-		
-		UGMCAbilityEffect* Effect = DuplicateObject(Operation.ItemClass->GetDefaultObject<UGMCAbilityEffect>(), this);
-		FGMCAbilityEffectData EffectData = Operation.Payload;
 
-		if (!EffectData.IsValid())
+		const int EffectID = Operation.Header.PayloadIds.Ids.Num() > 0 ? Operation.Header.PayloadIds.Ids[0] : Operation.Payload.EffectID;
+		if (EffectID > 0 && ActiveEffects.Contains(EffectID))
 		{
-			EffectData = Effect->EffectData;
+			const auto& ExistingEffect = ActiveEffects[EffectID];
+			UE_LOG(LogGMCAbilitySystem, Warning, TEXT("[%20s] %s attempted to process an explicit ID add effect operation for %s with existing effect %d [%s]"),
+				*GetNetRoleAsString(GetOwnerRole()), *GetOwner()->GetName(), *Operation.ItemClass->GetName(), EffectID, *ExistingEffect->GetClass()->GetName())
+			return nullptr;
 		}
-		
-		if (Operation.Header.PayloadIds.Ids.Num() > 0)
+
+		UGMCAbilityEffect* Effect = NewObject<UGMCAbilityEffect>(this, Operation.ItemClass);
+		if (Operation.Payload.IsValid())
 		{
-			EffectData.EffectID = Operation.Header.PayloadIds.Ids[0];
+			// The payload overrides the class definition, so it has to be used in full.
+			FGMCAbilityEffectData EffectData = Operation.Payload;
+			EffectData.EffectID = EffectID;
+			ApplyAbilityEffect(Effect, EffectData);
 		}
-
-		if (EffectData.EffectID > 0 && ActiveEffects.Contains(EffectData.EffectID))
+		else
 		{
-			const auto& ExistingEffect = ActiveEffects[EffectData.EffectID];
-			UE_LOG(LogGMCAbilitySystem, Warning, TEXT("[%20s] %s attempted to process an explicit ID add effect operation for %s with existing effect %d [%s]"),
-				*GetNetRoleAsString(GetOwnerRole()), *GetOwner()->GetName(), *Effect->GetClass()->GetName(), EffectData.EffectID, *ExistingEffect->GetClass()->GetName())
-			return nullptr;
+			// Otherwise the new instance already holds the class definition; only apply the instance state.
+			FGMCAbilityEffectInstanceData InstanceData(Operation.ItemClass, Operation.Payload);
+			InstanceData.EffectID = EffectID;
+			ApplyAbilityEffect(Effect, InstanceData);
 		}
-		
-		ApplyAbilityEffect(Effect, EffectData);
 
 		for (auto& [EffectHandle, EffectHandleData] : EffectHandles)
 		{
 			// If we don't already have a known effect ID, attach it to our handle now.
 			if (EffectHandleData.NetworkId <= 0 && EffectHandleData.OperationId == Operation.Header.OperationId)
 			{
-				EffectHandleData.NetworkId = Effect->EffectData.EffectID;
+				EffectHandleData.NetworkId = Effect->GetEffectID();
 			}
 		}
 		
@@ -1404,7 +2035,7 @@ bool UGMC_AbilitySystemComponent::ShouldProcessOperation(
 	if (bIsServer)
 	{
 		return HasAuthority() && (QueuedOperations.IsAcknowledged(Operation.GetOperationId()) ||
-			Operation.GracePeriodExpired() || GetNetMode() == NM_Standalone);
+			QueuedOperations.IsGracePeriodExpired(Operation) || IsAuthorityOnly());
 	}
 	else
 	{
@@ -1450,23 +2081,91 @@ void UGMC_AbilitySystemComponent::AddImpulseEvent(const FGMASSyncedEventContaine
 void UGMC_AbilitySystemComponent::ClientQueueOperation(
 	const TGMASBoundQueueOperation<UGMCAbilityEffect, FGMCAbilityEffectData>& Operation)
 {
-	RPCClientQueueEffectOperation(Operation.Header);
+	DeferClientQueueOperation(Operation.Header, EGMASClientQueuedOperationType::Effect);
 }
 
 void UGMC_AbilitySystemComponent::ClientQueueOperation(
 	const TGMASBoundQueueOperation<UGMASSyncedEvent, FGMASSyncedEventContainer>& Operation)
 {
-	RPCClientQueueEventOperation(Operation.Header);
+	DeferClientQueueOperation(Operation.Header, EGMASClientQueuedOperationType::Event);
+}
+
+void UGMC_AbilitySystemComponent::DeferClientQueueOperation(const FGMASBoundQueueRPCHeader& Header, EGMASClientQueuedOperationType Type)
+{
+	// Nobody to send it to.
+	if (bServerOnlyMode) return;
+
+	PendingClientOperations.Add(Header, Type);
+
+	if (bClientOperationFlushScheduled) return;
+
+	if (const UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().SetTimerForNextTick(this, &UGMC_AbilitySystemComponent::FlushClientQueueOperations);
+		bClientOperationFlushScheduled = true;
+	}
+	else
+	{
+		FlushClientQueueOperations();
+	}
+}
+
+void UGMC_AbilitySystemComponent::FlushClientQueueOperations()
+{
+	bClientOperationFlushScheduled = false;
+	if (PendingClientOperations.Num() == 0) return;
+
+	RPCClientQueueOperations(PendingClientOperations);
+	PendingClientOperations.Reset();
 }
 
-void UGMC_AbilitySystemComponent::RPCClientQueueEventOperation_Implementation(const FGMASBoundQueueRPCHeader& Header)
+void UGMC_AbilitySystemComponent::RPCClientQueueOperations_Implementation(const FGMASClientQueuedOperations& Operations)
 {
-	QueuedEventOperations.QueueOperationFromHeader(Header, false);
+	if (Operations.Types.Num() != Operations.Batch.Operations.Num())
+	{
+		UE_LOG(LogGMCAbilitySystem, Error, TEXT("Received %d queued operations with %d types, discarding them."),
+			Operations.Batch.Operations.Num(), Operations.Types.Num());
+		return;
+	}
+
+	// Queue in the order the server queued them, whichever queue each belongs to.
+	for (int32 Idx = 0; Idx < Operations.Batch.Operations.Num(); Idx++)
+	{
+		const FGMASBoundQueueRPCHeader& Header = Operations.Batch.Operations[Idx];
+		switch (Operations.Types[Idx])
+		{
+		case EGMASClientQueuedOperationType::Effect:
+			QueuedEffectOperations.QueueOperationFromHeader(Header, false);
+			break;
+		case EGMASClientQueuedOperationType::Event:
+			QueuedEventOperations.QueueOperationFromHeader(Header, false);
+			break;
+		}
+	}
 }
 
-void UGMC_AbilitySystemComponent::RPCClientQueueEffectOperation_Implementation(const FGMASBoundQueueRPCHeader& Header)
+bool FGMASClientQueuedOperations::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
 {
-	QueuedEffectOperations.QueueOperationFromHeader(Header, false);
+	Batch.NetSerialize(Ar, Map, bOutSuccess);
+	if (!bOutSuccess) return true;
+
+	if (Ar.IsLoading())
+	{
+		Types.SetNumUninitialized(Batch.Operations.Num());
+	}
+	for (EGMASClientQueuedOperationType& Type : Types)
+	{
+		uint8 bEvent = Type == EGMASClientQueuedOperationType::Event ? 1 : 0;
+		Ar.SerializeBits(&bEvent, 1);
+		Type = bEvent ? EGMASClientQueuedOperationType::Event : EGMASClientQueuedOperationType::Effect;
+	}
+
+	if (Ar.IsError())
+	{
+		bOutSuccess = false;
+	}
+
+	return true;
 }
 
 void UGMC_AbilitySystemComponent::OnRep_UnBoundAttributes()
@@ -1509,11 +2208,10 @@ int UGMC_AbilitySystemComponent::GetNextAvailableEffectID() const
 		return -1;
 	}
 		
-	int NewEffectID = static_cast<int>(ActionTimer * 100);
-	while (ActiveEffects.Contains(NewEffectID) || CheckIfEffectIDQueued(NewEffectID))
+	const int NewEffectID = FGMASIdAllocator::Allocate(ActionTimer, [this](int32 Id)
 	{
-		NewEffectID++;
-	}
+		return ActiveEffects.Contains(Id) || CheckIfEffectIDQueued(Id);
+	});
 	UE_LOG(LogGMCAbilitySystem, VeryVerbose, TEXT("[Server: %hhd] Generated Effect ID: %d"), HasAuthority(), NewEffectID);
 	
 	return NewEffectID;
@@ -1521,23 +2219,13 @@ int UGMC_AbilitySystemComponent::GetNextAvailableEffectID() const
 
 bool UGMC_AbilitySystemComponent::CheckIfEffectIDQueued(int EffectID) const
 {
-	for (const auto& Operation : QueuedEffectOperations.GetQueuedRPCOperations())
-	{
-		if (Operation.Payload.EffectID == EffectID)
-		{
-			return true;
-		}
-	}
-
-	for (const auto& Operation : QueuedEffectOperations_ClientAuth.GetQueuedRPCOperations())
-	{
-		if (Operation.Payload.EffectID == EffectID)
-		{
-			return true;
-		}
-	}
+	// Operations waiting for a move carry their effect ID too (e.g. several ServerAuthMove applications to one target).
+	return QueuedEffectOperations.HasOperationWithPayloadId(EffectID) || QueuedEffectOperations_ClientAuth.HasOperationWithPayloadId(EffectID);
+}
 
-	return false;
+const FGMCAbilityEffectData& UGMC_AbilitySystemComponent::GetEffectDefinition(const TSubclassOf<UGMCAbilityEffect>& EffectClass, const FGMCAbilityEffectData& EffectData)
+{
+	return EffectData.IsValid() ? EffectData : EffectClass->GetDefaultObject<UGMCAbilityEffect>()->GetDefinition();
 }
 
 int UGMC_AbilitySystemComponent::CreateEffectOperation(
@@ -1549,15 +2237,11 @@ int UGMC_AbilitySystemComponent::CreateEffectOperation(
 {
 	TArray<int> PayloadIds {};
 
-	FGMCAbilityEffectData PayloadData;
-	if (EffectData.IsValid())
-	{
-		PayloadData = EffectData;
-	}
-	else
-	{
-		PayloadData = EffectClass->GetDefaultObject<UGMCAbilityEffect>()->EffectData;
-	}
+	// If the initialization data doesn't override the class definition, it only carries instance state; the
+	// receiver takes the definition from the class itself, so we never copy the CDO's data into the operation.
+	FGMCAbilityEffectData PayloadData = EffectData;
+	const FGMCAbilityEffectData& Definition = GetEffectDefinition(EffectClass, EffectData);
+	PayloadData.DefinitionClass = EffectClass;
 
 	if (QueueType == EGMCAbilityEffectQueueType::ServerAuth)
 	{
@@ -1576,11 +2260,11 @@ int UGMC_AbilitySystemComponent::CreateEffectOperation(
 
 	if (QueueType == EGMCAbilityEffectQueueType::PredictedQueued || QueueType == EGMCAbilityEffectQueueType::ClientAuth)
 	{
-		QueuedEffectOperations_ClientAuth.MakeOperation(OutOperation, EGMASBoundQueueOperationType::Add, PayloadData.EffectTag, PayloadData, PayloadIds, EffectClass, 1.f, static_cast<uint8>(QueueType));
+		QueuedEffectOperations_ClientAuth.MakeOperation(OutOperation, EGMASBoundQueueOperationType::Add, Definition.EffectTag, PayloadData, PayloadIds, EffectClass, 1.f, static_cast<uint8>(QueueType));
 	}
 	else
 	{
-		QueuedEffectOperations.MakeOperation(OutOperation, EGMASBoundQueueOperationType::Add, PayloadData.EffectTag, PayloadData, PayloadIds, EffectClass, 1.f, static_cast<uint8>(QueueType));
+		QueuedEffectOperations.MakeOperation(OutOperation, EGMASBoundQueueOperationType::Add, Definition.EffectTag, PayloadData, PayloadIds, EffectClass, 1.f, static_cast<uint8>(QueueType));
 	}
 	return PayloadData.EffectID;
 }
@@ -1629,7 +2313,7 @@ UGMCAbilityEffect* UGMC_AbilitySystemComponent::ApplyAbilityEffect(TSubclassOf<U
 		return nullptr;
 	}
 
-	if (!GMCMovementComponent->IsExecutingMove() && GetNetMode() != NM_Standalone)
+	if (!GMCMovementComponent->IsExecutingMove() && !IsAuthorityOnly())
 	{
 		// For backwards compatibility, we do not reject this if we're outside a movement cycle. However, we will at least
 		// log it.
@@ -1639,21 +2323,10 @@ UGMCAbilityEffect* UGMC_AbilitySystemComponent::ApplyAbilityEffect(TSubclassOf<U
 	return ProcessOperation(Operation);
 }
 
-int32 UGMC_AbilitySystemComponent::GetNextAvailableEffectHandle() const
+int32 UGMC_AbilitySystemComponent::GetNextAvailableEffectHandle()
 {
-	if (ActionTimer == 0)
-	{
-		UE_LOG(LogGMCAbilitySystem, Error, TEXT("[ApplyAbilityEffect] Action Timer is 0, cannot generate Effect ID. Is it a listen server smoothed pawn?"));
-		return -1;
-	}
-		
-	int NewEffectHandle = static_cast<int>(ActionTimer * 100);
-	while (EffectHandles.Contains(NewEffectHandle))
-	{
-		NewEffectHandle++;
-	}
-	
-	return NewEffectHandle;	
+	// Handles never leave this machine, so they don't need to be derived from the action timer.
+	return EffectHandleAllocator.Allocate();
 }
 
 void UGMC_AbilitySystemComponent::GetEffectFromHandle_BP(int EffectHandle, bool& bOutSuccess, int32& OutEffectNetworkId,
@@ -1679,20 +2352,22 @@ bool UGMC_AbilitySystemComponent::GetEffectFromHandle(int EffectHandle, int32& O
 
 bool UGMC_AbilitySystemComponent::GetEffectHandle(int EffectHandle, FGMASQueueOperationHandle& HandleData) const
 {
-	for (auto& [ID, Handle] : EffectHandles)
+	if (!EffectHandleAllocator.IsValid(EffectHandle)) return false;
+
+	if (const FGMASQueueOperationHandle* Handle = EffectHandles.Find(EffectHandle))
 	{
-		if (Handle.Handle == EffectHandle)
-		{
-			HandleData = Handle;
-			return true;
-		}
+		HandleData = *Handle;
+		return true;
 	}
 	return false;
 }
 
 void UGMC_AbilitySystemComponent::RemoveEffectHandle(int EffectHandle)
 {
-	EffectHandles.Remove(EffectHandle);
+	if (EffectHandles.Remove(EffectHandle) > 0)
+	{
+		EffectHandleAllocator.Release(EffectHandle);
+	}
 }
 
 void UGMC_AbilitySystemComponent::ApplyAbilityEffectSafe(TSubclassOf<UGMCAbilityEffect> EffectClass,
@@ -1751,6 +2426,12 @@ bool UGMC_AbilitySystemComponent::ApplyAbilityEffect(TSubclassOf<UGMCAbilityEffe
 
 	FGMASQueueOperationHandle HandleData;
 	HandleData.Handle = GetNextAvailableEffectHandle();
+	if (HandleData.Handle == FGMASHandleAllocator::InvalidHandle)
+	{
+		UE_LOG(LogGMCAbilitySystem, Error, TEXT("[%20s] %s ran out of effect handles applying %s!"),
+			*GetNetRoleAsString(GetOwnerRole()), *GetOwner()->GetName(), *EffectClass->GetName())
+		return false;
+	}
 	HandleData.NetworkId = EffectID;
 	HandleData.OperationId = Operation.Header.OperationId;
 	
@@ -1760,7 +2441,7 @@ bool UGMC_AbilitySystemComponent::ApplyAbilityEffect(TSubclassOf<UGMCAbilityEffe
 	{
 	case EGMCAbilityEffectQueueType::Predicted:
 		{
-			if (!GMCMovementComponent->IsExecutingMove() && GetNetMode() != NM_Standalone && !bInAncillaryTick)
+			if (!GMCMovementComponent->IsExecutingMove() && !IsAuthorityOnly() && !bInAncillaryTick)
 			{
 				UE_LOG(LogGMCAbilitySystem, Error, TEXT("[%20s] %s attempted to apply predicted effect %d of type %s outside of a GMC move!"),
 					*GetNetRoleAsString(GetOwnerRole()), *GetOwner()->GetName(), EffectID, *EffectClass->GetName())
@@ -1769,7 +2450,7 @@ bool UGMC_AbilitySystemComponent::ApplyAbilityEffect(TSubclassOf<UGMCAbilityEffe
 
 			// Apply effect immediately.
 			OutEffect = ProcessOperation(Operation);
-			OutEffectId = OutEffect->EffectData.EffectID;
+			OutEffectId = OutEffect->GetEffectID();
 			OutEffectHandle = HandleData.Handle;
 			return true;
 		}
@@ -1779,7 +2460,7 @@ bool UGMC_AbilitySystemComponent::ApplyAbilityEffect(TSubclassOf<UGMCAbilityEffe
 			{
 				// We're in a move context, just add it directly rather than queuing.
 				OutEffect = ProcessOperation(Operation);
-				OutEffectId = OutEffect->EffectData.EffectID;
+				OutEffectId = OutEffect->GetEffectID();
 			}
 			else
 			{
@@ -1799,7 +2480,7 @@ bool UGMC_AbilitySystemComponent::ApplyAbilityEffect(TSubclassOf<UGMCAbilityEffe
 				return false;
 			}
 
-			if (QueueType == EGMCAbilityEffectQueueType::ServerAuthMove) Operation.Header.RPCGracePeriodSeconds = Operation.Payload.ClientGraceTime;;
+			if (QueueType == EGMCAbilityEffectQueueType::ServerAuthMove) Operation.Header.RPCGracePeriodSeconds = GetEffectDefinition(EffectClass, Operation.Payload).ClientGraceTime;
 
 			QueuedEffectOperations.QueuePreparedOperation(Operation, QueueType == EGMCAbilityEffectQueueType::ServerAuthMove);
 
@@ -1816,7 +2497,7 @@ bool UGMC_AbilitySystemComponent::ApplyAbilityEffect(TSubclassOf<UGMCAbilityEffe
 
 	case EGMCAbilityEffectQueueType::ClientAuth:
 		{
-			if (GetNetMode() != NM_Standalone && !GMCMovementComponent->IsAutonomousProxy() && !GMCMovementComponent->IsLocallyControlledServerPawn())
+			if (!IsAuthorityOnly() && !GMCMovementComponent->IsAutonomousProxy() && !GMCMovementComponent->IsLocallyControlledServerPawn())
 			{
 				UE_LOG(LogGMCAbilitySystem, Error, TEXT("[%20s] %s attempted to apply client-auth effect %d of type %s on a server!"),
 					*GetNetRoleAsString(GetOwnerRole()), *GetOwner()->GetName(), EffectID, *EffectClass->GetName())
@@ -1834,6 +2515,77 @@ bool UGMC_AbilitySystemComponent::ApplyAbilityEffect(TSubclassOf<UGMCAbilityEffe
 	return false;
 }
 
+int32 UGMC_AbilitySystemComponent::ApplyAbilityEffectToTargets(TSubclassOf<UGMCAbilityEffect> EffectClass,
+	FGMCAbilityEffectData InitializationData, const TArray<UGMC_AbilitySystemComponent*>& Targets,
+	EGMCAbilityEffectQueueType QueueType, TArray<int>& OutEffectIds)
+{
+	OutEffectIds.Reset(Targets.Num());
+
+	if (EffectClass == nullptr)
+	{
+		UE_LOG(LogGMCAbilitySystem, Error, TEXT("Trying to apply Effect to targets, but effect is null!"));
+		return 0;
+	}
+
+	if (!HasAuthority())
+	{
+		UE_LOG(LogGMCAbilitySystem, Error, TEXT("[%20s] %s attempted to apply effect of type %s to multiple targets on a client!"),
+			*GetNetRoleAsString(GetOwnerRole()), *GetOwner()->GetName(), *EffectClass->GetName())
+		return 0;
+	}
+
+	if (QueueType != EGMCAbilityEffectQueueType::ServerAuth && QueueType != EGMCAbilityEffectQueueType::ServerAuthMove)
+	{
+		UE_LOG(LogGMCAbilitySystem, Error, TEXT("[%20s] %s attempted to apply effect of type %s to multiple targets with unsupported queue type %s!"),
+			*GetNetRoleAsString(GetOwnerRole()), *GetOwner()->GetName(), *EffectClass->GetName(), *UEnum::GetValueAsString(QueueType))
+		return 0;
+	}
+
+	// Build and encode the payload once; every target gets a clone of this operation with only its IDs changed.
+	TGMASBoundQueueOperation<UGMCAbilityEffect, FGMCAbilityEffectData> TemplateOperation;
+	CreateEffectOperation(TemplateOperation, EffectClass, InitializationData, false, QueueType);
+	if (QueueType == EGMCAbilityEffectQueueType::ServerAuthMove)
+	{
+		TemplateOperation.Header.RPCGracePeriodSeconds = GetEffectDefinition(EffectClass, TemplateOperation.Payload).ClientGraceTime;
+	}
+
+	int32 NumApplied = 0;
+	TGMASBoundQueueOperation<UGMCAbilityEffect, FGMCAbilityEffectData> Operation;
+	for (UGMC_AbilitySystemComponent* Target : Targets)
+	{
+		if (!IsValid(Target))
+		{
+			OutEffectIds.Add(-1);
+			continue;
+		}
+
+		const int EffectID = Target->GetNextAvailableEffectID();
+		if (EffectID == -1)
+		{
+			UE_LOG(LogGMCAbilitySystem, Error, TEXT("[%20s] %s could not create an effect of type %s on %s!"),
+				*GetNetRoleAsString(GetOwnerRole()), *GetOwner()->GetName(), *EffectClass->GetName(), *GetNameSafe(Target->GetOwner()))
+			OutEffectIds.Add(-1);
+			continue;
+		}
+
+		Target->QueuedEffectOperations.MakeOperationFromTemplate(Operation, TemplateOperation, { EffectID });
+
+		// Keep the local payload in line with a regular operation; the encoded payload gets it from the payload IDs.
+		Operation.Payload.EffectID = EffectID;
+
+		Target->QueuedEffectOperations.QueuePreparedOperation(Operation, QueueType == EGMCAbilityEffectQueueType::ServerAuthMove);
+		if (QueueType == EGMCAbilityEffectQueueType::ServerAuth)
+		{
+			Target->ClientQueueOperation(Operation);
+		}
+
+		OutEffectIds.Add(EffectID);
+		NumApplied++;
+	}
+
+	return NumApplied;
+}
+
 UGMCAbilityEffect* UGMC_AbilitySystemComponent::GetEffectById(const int EffectId) const
 {
 	if (!ActiveEffects.Contains(EffectId)) return nullptr;
@@ -1880,8 +2632,29 @@ UGMCAbilityEffect* UGMC_AbilitySystemComponent::ApplyAbilityEffect(UGMCAbilityEf
 	InitializationData.SourceAbilityComponent = this;
 	
 	Effect->InitializeEffect(InitializationData);
-	
-	if (Effect->EffectData.EffectID == 0)
+
+	return AddActiveEffect(Effect);
+}
+
+UGMCAbilityEffect* UGMC_AbilitySystemComponent::ApplyAbilityEffect(UGMCAbilityEffect* Effect, const FGMCAbilityEffectInstanceData& InstanceData)
+{
+	if (Effect == nullptr) {
+		UE_LOG(LogGMCAbilitySystem, Error, TEXT("Trying to apply Effect, but effect is null!"));
+		return nullptr;
+	}
+
+	// Force the component this is being applied to to be the owner
+	FGMCAbilityEffectInstanceData OwnedInstanceData = InstanceData;
+	OwnedInstanceData.SourceAbilityComponent = this;
+
+	Effect->InitializeEffectInstance(this, OwnedInstanceData);
+
+	return AddActiveEffect(Effect);
+}
+
+UGMCAbilityEffect* UGMC_AbilitySystemComponent::AddActiveEffect(UGMCAbilityEffect* Effect)
+{
+	if (Effect->GetEffectID() == 0)
 	{
 		Effect->EffectData.EffectID = GetNextAvailableEffectID();
 	}
@@ -1889,14 +2662,14 @@ UGMCAbilityEffect* UGMC_AbilitySystemComponent::ApplyAbilityEffect(UGMCAbilityEf
 	// This is Replicated, so only server needs to manage it
 	if (HasAuthority())
 	{
-		ActiveEffectsData.Push(Effect->EffectData);
+		ActiveEffectsData.Push(Effect->GetInstanceData());
 	}
 	else
 	{
-		ProcessedEffectIDs.Add(Effect->EffectData.EffectID, EGMCEffectAnswerState::Pending);
+		ProcessedEffectIDs.Add(Effect->GetEffectID(), EGMCEffectAnswerState::Pending);
 	}
 
-	ActiveEffects.Add(Effect->EffectData.EffectID, Effect);
+	ActiveEffects.Add(Effect->GetEffectID(), Effect);
 	
 	return Effect;
 }
@@ -1908,7 +2681,7 @@ void UGMC_AbilitySystemComponent::RemoveActiveAbilityEffect(UGMCAbilityEffect* E
 		return;
 	}
 	
-	if (!ActiveEffects.Contains(Effect->EffectData.EffectID)) return;
+	if (!ActiveEffects.Contains(Effect->GetEffectID())) return;
 	
 	Effect->EndEffect();
 }
@@ -1939,7 +2712,7 @@ void UGMC_AbilitySystemComponent::RemoveActiveAbilityEffectSafe(UGMCAbilityEffec
 	}
 		
 	
-	RemoveEffectByIdSafe({ Effect->EffectData.EffectID }, QueueType);
+	RemoveEffectByIdSafe({ Effect->GetEffectID() }, QueueType);
 }
 
 
@@ -1947,7 +2720,7 @@ void UGMC_AbilitySystemComponent::RemoveActiveAbilityEffectByTag(FGameplayTag Ta
 
 	for (auto& [EffectId, Effect] : ActiveEffects)
 	{
-		if (IsValid(Effect) && Tag.MatchesTag(Effect->EffectData.EffectTag))
+		if (IsValid(Effect) && Tag.MatchesTag(Effect->GetDefinition().EffectTag))
 		{
 			RemoveEffectByIdSafe({ EffectId }, QueueType);
 			if (!bAllInstance) {
@@ -1973,8 +2746,8 @@ TArray<int> UGMC_AbilitySystemComponent::EffectsMatchingTag(const FGameplayTag&
 			break;
 		}
 		
-		if(Effect.Value->EffectData.EffectTag.IsValid() && Effect.Value->EffectData.EffectTag.MatchesTagExact(Tag)){
-			EffectsToRemove.Add(Effect.Value->EffectData.EffectID);
+		if(Effect.Value->GetDefinition().EffectTag.IsValid() && Effect.Value->GetDefinition().EffectTag.MatchesTagExact(Tag)){
+			EffectsToRemove.Add(Effect.Value->GetEffectID());
 			NumRemoved++;
 		}
 	}
@@ -2024,11 +2797,11 @@ int UGMC_AbilitySystemComponent::RemoveEffectsByQuery(const FGameplayTagQuery& Q
 	{
 		if (UGMCAbilityEffect* Effect = EffectEntry.Value)
 		{
-			if (Query.Matches(Effect->EffectData.EffectDefinition))
+			if (Query.Matches(Effect->GetDefinition().EffectDefinition))
 			{
 				RemoveActiveAbilityEffectSafe(Effect, QueueType);
 				EffectsRemoved++;
-				UE_LOG(LogGMCAbilitySystem, Verbose, TEXT("Removed effect %s by query"), *Effect->EffectData.EffectTag.ToString());
+				UE_LOG(LogGMCAbilitySystem, Verbose, TEXT("Removed effect %s by query"), *Effect->GetDefinition().EffectTag.ToString());
 			}
 		}
 	}
@@ -2053,7 +2826,7 @@ bool UGMC_AbilitySystemComponent::RemoveEffectByIdSafe(TArray<int> Ids, EGMCAbil
 	switch(QueueType) {
 		case EGMCAbilityEffectQueueType::Predicted:
 			{
-				if (!GMCMovementComponent->IsExecutingMove() && GetNetMode() != NM_Standalone && !bInAncillaryTick)
+				if (!GMCMovementComponent->IsExecutingMove() && !IsAuthorityOnly() && !bInAncillaryTick)
 				{
 
 					ensureMsgf(false, TEXT("[%20s] %s attempted a predicted removal of effects outside of a movement cycle! (%s)"),
@@ -2105,7 +2878,7 @@ bool UGMC_AbilitySystemComponent::RemoveEffectByIdSafe(TArray<int> Ids, EGMCAbil
 			{
 				if (QueueType == EGMCAbilityEffectQueueType::ClientAuth)
 				{
-					if (GetNetMode() != NM_Standalone && (HasAuthority() && !GMCMovementComponent->IsLocallyControlledServerPawn()))
+					if (!IsAuthorityOnly() && (HasAuthority() && !GMCMovementComponent->IsLocallyControlledServerPawn()))
 					{
 						ensureMsgf(false, TEXT("[%20s] %s attempted a client-auth removal of %d effects on a server! (%s)"),
 							*GetNetRoleAsString(GetOwnerRole()), *GetOwner()->GetName(), Ids.Num(), *GetEffectsNameAsString(GetEffectsByIds(Ids)));
@@ -2179,7 +2952,7 @@ int32 UGMC_AbilitySystemComponent::GetNumEffectByTag(FGameplayTag InEffectTag){
 	if(!InEffectTag.IsValid()) return -1;
 	int32 Count = 0;
 	for (const TTuple<int, UGMCAbilityEffect*> Effect : ActiveEffects){
-		if(Effect.Value->EffectData.EffectTag.IsValid() && Effect.Value->EffectData.EffectTag.MatchesTagExact(InEffectTag)){
+		if(Effect.Value->GetDefinition().EffectTag.IsValid() && Effect.Value->GetDefinition().EffectTag.MatchesTagExact(InEffectTag)){
 			Count++;
 		}
 	}
@@ -2220,6 +2993,36 @@ const FAttribute* UGMC_AbilitySystemComponent::GetAttributeByTag(FGameplayTag At
 	return nullptr;
 }
 
+const FAttribute* UGMC_AbilitySystemComponent::GetAttributeByTag(FGameplayTag AttributeTag, int32& InOutSlot) const
+{
+	// Slots index unbound then bound attributes, in the same order as GetAllAttributes.
+	const int32 NumUnbound = UnBoundAttributes.Items.Num();
+	auto GetAttributeAtSlot = [this, NumUnbound](int32 Slot) -> const FAttribute*
+	{
+		if (Slot < 0) return nullptr;
+		if (Slot < NumUnbound) return &UnBoundAttributes.Items[Slot];
+		return BoundAttributes.Attributes.IsValidIndex(Slot - NumUnbound) ? &BoundAttributes.Attributes[Slot - NumUnbound] : nullptr;
+	};
+
+	const FAttribute* Attribute = GetAttributeAtSlot(InOutSlot);
+	if (Attribute && Attribute->Tag == AttributeTag) return Attribute;
+
+	InOutSlot = INDEX_NONE;
+	if (!AttributeTag.IsValid()) return nullptr;
+
+	const int32 NumSlots = NumUnbound + BoundAttributes.Attributes.Num();
+	for (int32 Slot = 0; Slot < NumSlots; Slot++)
+	{
+		Attribute = GetAttributeAtSlot(Slot);
+		if (Attribute->Tag == AttributeTag)
+		{
+			InOutSlot = Slot;
+			return Attribute;
+		}
+	}
+	return nullptr;
+}
+
 float UGMC_AbilitySystemComponent::GetAttributeValueByTag(const FGameplayTag AttributeTag) const
 {
 	if (const FAttribute* Att = GetAttributeByTag(AttributeTag))
@@ -2290,7 +3093,7 @@ FString UGMC_AbilitySystemComponent::GetAllAttributesString() const{
 
 FString UGMC_AbilitySystemComponent::GetActiveEffectsDataString() const{
 	FString FinalString = FString::Printf(TEXT("%d total\n"), ActiveEffectsData.Num());
-	for(const FGMCAbilityEffectData& ActiveEffectData : ActiveEffectsData){
+	for(const FGMCAbilityEffectInstanceData& ActiveEffectData : ActiveEffectsData){
 		FinalString += ActiveEffectData.ToString() + TEXT("\n");
 	}
 	return FinalString;
@@ -2463,6 +3266,7 @@ void UGMC_AbilitySystemComponent::GetLifetimeReplicatedProps(TArray< FLifetimePr
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 	DOREPLIFETIME_CONDITION(UGMC_AbilitySystemComponent, ActiveEffectsData, COND_OwnerOnly);
+	DOREPLIFETIME_CONDITION(UGMC_AbilitySystemComponent, ServerClassRegistryHash, COND_OwnerOnly);
 	DOREPLIFETIME(UGMC_AbilitySystemComponent, UnBoundAttributes);
 }
 
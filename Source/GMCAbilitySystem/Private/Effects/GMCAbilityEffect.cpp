@@ -7,6 +7,7 @@
 #include "Components/GMCAbilityComponent.h"
 #include "Interfaces/IPluginManager.h"
 #include "Kismet/KismetSystemLibrary.h"
+#include "UObject/CoreNet.h"
 
 #if WITH_EDITOR
 void UGMCAbilityEffect::PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent)
@@ -17,10 +18,328 @@ void UGMCAbilityEffect::PostEditChangeProperty(struct FPropertyChangedEvent& Pro
 }
 #endif
 
-void UGMCAbilityEffect::InitializeEffect(FGMCAbilityEffectData InitializationData)
+namespace
+{
+	// Number of fields visited by VisitEffectDataNetFields, i.e. the width of the changed-field mask.
+	constexpr int32 EffectDataNetFieldCount = 31;
+
+	// Visits every replicated field of the effect data alongside its baseline value. The order defines the bit order
+	// of the changed-field mask, so new fields must be appended and EffectDataNetFieldCount bumped (max 64).
+	template<typename DataType, typename VisitorType>
+	void VisitEffectDataNetFields(DataType& Data, const FGMCAbilityEffectData& Baseline, VisitorType&& Visitor)
+	{
+		Visitor(Data.SourceAbilityComponent, Baseline.SourceAbilityComponent);
+		Visitor(Data.OwnerAbilityComponent, Baseline.OwnerAbilityComponent);
+		Visitor(Data.EffectID, Baseline.EffectID);
+
+		// Bitfields can't be bound to a reference.
+		bool bServerAuth = Data.bServerAuth;
+		const bool bBaselineServerAuth = Baseline.bServerAuth;
+		Visitor(bServerAuth, bBaselineServerAuth);
+		if constexpr (!std::is_const_v<DataType>)
+		{
+			Data.bServerAuth = bServerAuth;
+		}
+
+		Visitor(Data.StartTime, Baseline.StartTime);
+		Visitor(Data.EndTime, Baseline.EndTime);
+		Visitor(Data.CurrentDuration, Baseline.CurrentDuration);
+		Visitor(Data.EffectType, Baseline.EffectType);
+		Visitor(Data.bNegateEffectAtEnd, Baseline.bNegateEffectAtEnd);
+		Visitor(Data.Delay, Baseline.Delay);
+		Visitor(Data.bPeriodicFirstTick, Baseline.bPeriodicFirstTick);
+		Visitor(Data.PeriodicInterval, Baseline.PeriodicInterval);
+		Visitor(Data.Duration, Baseline.Duration);
+		Visitor(Data.ClientGraceTime, Baseline.ClientGraceTime);
+		Visitor(Data.EffectTag, Baseline.EffectTag);
+		Visitor(Data.GrantedTags, Baseline.GrantedTags);
+		Visitor(Data.bPreserveGrantedTagsIfMultiple, Baseline.bPreserveGrantedTagsIfMultiple);
+		Visitor(Data.ApplicationMustHaveTags, Baseline.ApplicationMustHaveTags);
+		Visitor(Data.ApplicationMustNotHaveTags, Baseline.ApplicationMustNotHaveTags);
+		Visitor(Data.MustHaveTags, Baseline.MustHaveTags);
+		Visitor(Data.MustNotHaveTags, Baseline.MustNotHaveTags);
+		Visitor(Data.GrantedAbilities, Baseline.GrantedAbilities);
+		Visitor(Data.PauseEffect, Baseline.PauseEffect);
+		Visitor(Data.CancelAbilityOnActivation, Baseline.CancelAbilityOnActivation);
+		Visitor(Data.CancelAbilityOnEnd, Baseline.CancelAbilityOnEnd);
+		Visitor(Data.Modifiers, Baseline.Modifiers);
+		Visitor(Data.EffectDefinition, Baseline.EffectDefinition);
+		Visitor(Data.ActivationQuery, Baseline.ActivationQuery);
+		Visitor(Data.MustMaintainQuery, Baseline.MustMaintainQuery);
+		Visitor(Data.EndAbilityOnActivationQuery, Baseline.EndAbilityOnActivationQuery);
+		Visitor(Data.EndAbilityOnEndQuery, Baseline.EndAbilityOnEndQuery);
+	}
+
+	template<typename T>
+	void SerializeEffectDataNetField(FArchive& Ar, UPackageMap* Map, T& Value, bool& bOutSuccess)
+	{
+		Ar << Value;
+	}
+
+	void SerializeEffectDataNetField(FArchive& Ar, UPackageMap* Map, UGMC_AbilitySystemComponent*& Value, bool& bOutSuccess)
+	{
+		// Object references can only be resolved through a package map.
+		if (!Map) return;
+
+		UObject* Object = Value;
+		bOutSuccess &= Map->SerializeObject(Ar, UGMC_AbilitySystemComponent::StaticClass(), Object);
+		if (Ar.IsLoading())
+		{
+			Value = Cast<UGMC_AbilitySystemComponent>(Object);
+		}
+	}
+
+	void SerializeEffectDataNetField(FArchive& Ar, UPackageMap* Map, FGameplayTag& Value, bool& bOutSuccess)
+	{
+		bool bTagSuccess = true;
+		Value.NetSerialize(Ar, Map, bTagSuccess);
+		bOutSuccess &= bTagSuccess;
+	}
+
+	void SerializeEffectDataNetField(FArchive& Ar, UPackageMap* Map, FGameplayTagContainer& Value, bool& bOutSuccess)
+	{
+		bool bTagSuccess = true;
+		Value.NetSerialize(Ar, Map, bTagSuccess);
+		bOutSuccess &= bTagSuccess;
+	}
+
+	void SerializeEffectDataNetField(FArchive& Ar, UPackageMap* Map, FGameplayTagQuery& Value, bool& bOutSuccess)
+	{
+		// Queries have no net serializer of their own.
+		FGameplayTagQuery::StaticStruct()->SerializeBin(Ar, &Value);
+	}
+
+	void SerializeEffectDataNetField(FArchive& Ar, UPackageMap* Map, TArray<FGMCAttributeModifier>& Value, bool& bOutSuccess)
+	{
+		uint32 NumModifiers = Value.Num();
+		Ar.SerializeIntPacked(NumModifiers);
+		if (Ar.IsLoading())
+		{
+			if (NumModifiers > 1024)
+			{
+				Ar.SetError();
+				bOutSuccess = false;
+				return;
+			}
+			Value.SetNum(NumModifiers);
+		}
+
+		for (FGMCAttributeModifier& Modifier : Value)
+		{
+			bool bModifierSuccess = true;
+			Modifier.NetSerialize(Ar, Map, bModifierSuccess);
+			bOutSuccess &= bModifierSuccess;
+		}
+	}
+
+	// Object references can't be written without a package map, so they never count as changed without one.
+	bool IsEffectDataNetFieldSerializable(UPackageMap* Map, UGMC_AbilitySystemComponent* Value) { return Map != nullptr; }
+	template<typename T>
+	bool IsEffectDataNetFieldSerializable(UPackageMap* Map, const T& Value) { return true; }
+}
+
+bool FGMCAbilityEffectData::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	static const FGMCAbilityEffectData DefaultEffectData;
+	bOutSuccess = true;
+
+	// Only payloads carrying a full definition are delta'd against their class; instance-only payloads are delta'd
+	// against the struct defaults, so the receiver sees exactly what was sent either way.
+	uint8 bClassBaseline = Ar.IsSaving() && DefinitionClass && IsValid();
+	Ar.SerializeBits(&bClassBaseline, 1);
+
+	if (bClassBaseline)
+	{
+		if (Map)
+		{
+			UObject* ClassObject = DefinitionClass.Get();
+			bOutSuccess &= Map->SerializeObject(Ar, UClass::StaticClass(), ClassObject);
+			if (Ar.IsLoading())
+			{
+				DefinitionClass = Cast<UClass>(ClassObject);
+			}
+		}
+		else
+		{
+			FString ClassPath = Ar.IsSaving() ? DefinitionClass->GetPathName() : FString();
+			Ar << ClassPath;
+			if (Ar.IsLoading())
+			{
+				DefinitionClass = FSoftClassPath(ClassPath).TryLoadClass<UGMCAbilityEffect>();
+			}
+		}
+
+		if (Ar.IsLoading() && !DefinitionClass)
+		{
+			UE_LOG(LogGMCAbilitySystem, Error, TEXT("Effect data received for an unknown effect class; deserializing against defaults."));
+			bOutSuccess = false;
+		}
+	}
+	else if (Ar.IsLoading())
+	{
+		DefinitionClass = nullptr;
+	}
+
+	const FGMCAbilityEffectData& Baseline = bClassBaseline && DefinitionClass ? DefinitionClass->GetDefaultObject<UGMCAbilityEffect>()->GetDefinition() : DefaultEffectData;
+
+	uint64 ChangedFields = 0;
+	if (Ar.IsSaving())
+	{
+		int32 FieldIndex = 0;
+		VisitEffectDataNetFields(*this, Baseline, [&](const auto& Value, const auto& BaselineValue)
+		{
+			if (IsEffectDataNetFieldSerializable(Map, Value) && !(Value == BaselineValue))
+			{
+				ChangedFields |= 1ull << FieldIndex;
+			}
+			FieldIndex++;
+		});
+		checkSlow(FieldIndex == EffectDataNetFieldCount);
+	}
+
+	Ar.SerializeBits(&ChangedFields, EffectDataNetFieldCount);
+
+	int32 FieldIndex = 0;
+	VisitEffectDataNetFields(*this, Baseline, [&](auto& Value, const auto& BaselineValue)
+	{
+		const bool bChanged = (ChangedFields & (1ull << FieldIndex++)) != 0;
+		if (Ar.IsLoading() && !bChanged)
+		{
+			Value = BaselineValue;
+		}
+		else if (bChanged)
+		{
+			// A changed bool can only be the opposite of its baseline, so the mask bit is the value.
+			if constexpr (std::is_same_v<std::decay_t<decltype(Value)>, bool>)
+			{
+				Value = !BaselineValue;
+			}
+			else
+			{
+				SerializeEffectDataNetField(Ar, Map, Value, bOutSuccess);
+			}
+		}
+	});
+
+	if (Ar.IsError())
+	{
+		bOutSuccess = false;
+	}
+
+	return true;
+}
+
+namespace
+{
+	void CopyEffectInstanceState(FGMCAbilityEffectData& To, const FGMCAbilityEffectData& From)
+	{
+		To.SourceAbilityComponent = From.SourceAbilityComponent;
+		To.OwnerAbilityComponent = From.OwnerAbilityComponent;
+		To.EffectID = From.EffectID;
+		To.bServerAuth = From.bServerAuth;
+		To.StartTime = From.StartTime;
+		To.EndTime = From.EndTime;
+		To.CurrentDuration = From.CurrentDuration;
+	}
+
+	// Whether Data's definition matches Baseline's, whatever their instance state.
+	bool EffectDefinitionMatches(const FGMCAbilityEffectData& Data, const FGMCAbilityEffectData& Baseline)
+	{
+		// The instance state comes first in the visiting order.
+		constexpr int32 NumInstanceStateFields = 7;
+
+		int32 FieldIndex = 0;
+		bool bMatches = true;
+		VisitEffectDataNetFields(Data, Baseline, [&](const auto& Value, const auto& BaselineValue)
+		{
+			bMatches &= FieldIndex++ < NumInstanceStateFields || Value == BaselineValue;
+		});
+		return bMatches;
+	}
+
+	// A definition held apart from the instance state; it replicates as a delta against its class defaults.
+	TUniquePtr<FGMCAbilityEffectData> MakeDefinitionOverrides(const FGMCAbilityEffectData& Data, UClass* EffectClass)
+	{
+		TUniquePtr<FGMCAbilityEffectData> Overrides = MakeUnique<FGMCAbilityEffectData>(Data);
+		CopyEffectInstanceState(*Overrides, FGMCAbilityEffectData());
+		Overrides->DefinitionClass = EffectClass;
+		return Overrides;
+	}
+}
+
+void UGMCAbilityEffect::InitializeEffect(const FGMCAbilityEffectData& InitializationData)
+{
+	// Data carrying the class definition, as most applications do, shares it rather than holding a copy.
+	if (EffectDefinitionMatches(InitializationData, GetClass()->GetDefaultObject<UGMCAbilityEffect>()->EffectData))
+	{
+		DefinitionOverrides.Reset();
+	}
+	else
+	{
+		DefinitionOverrides = MakeDefinitionOverrides(InitializationData, GetClass());
+	}
+	SetInstanceState(InitializationData);
+	BeginEffectInstance();
+}
+
+void UGMCAbilityEffect::InitializeEffectInstance(UGMC_AbilitySystemComponent* InOwnerAbilityComponent, const FGMCAbilityEffectInstanceData& InstanceData)
+{
+	if (const FGMCAbilityEffectData* Overrides = InstanceData.DefinitionOverrides.GetPtr<FGMCAbilityEffectData>())
+	{
+		DefinitionOverrides = MakeDefinitionOverrides(*Overrides, GetClass());
+	}
+
+	FGMCAbilityEffectData InstanceState;
+	InstanceState.OwnerAbilityComponent = InOwnerAbilityComponent;
+	InstanceState.SourceAbilityComponent = InstanceData.SourceAbilityComponent;
+	InstanceState.EffectID = InstanceData.EffectID;
+	InstanceState.bServerAuth = InstanceData.bServerAuth;
+	InstanceState.StartTime = InstanceData.StartTime;
+	InstanceState.EndTime = InstanceData.EndTime;
+	SetInstanceState(InstanceState);
+	BeginEffectInstance();
+}
+
+void UGMCAbilityEffect::SetInstanceState(const FGMCAbilityEffectData& Data)
+{
+	// Replaces the copy of the definition we were created with, so instances using their class defaults don't
+	// each hold their own.
+	FGMCAbilityEffectData InstanceState;
+	CopyEffectInstanceState(InstanceState, Data);
+	EffectData = MoveTemp(InstanceState);
+	bInstanceStateOnly = true;
+}
+
+FGMCAbilityEffectData& UGMCAbilityEffect::GetMutableDefinition()
+{
+	if (!bInstanceStateOnly) return EffectData;
+
+	if (!DefinitionOverrides)
+	{
+		DefinitionOverrides = MakeDefinitionOverrides(GetDefinition(), GetClass());
+	}
+	return *DefinitionOverrides;
+}
+
+FGMCAbilityEffectData UGMCAbilityEffect::GetEffectData() const
+{
+	FGMCAbilityEffectData Data = GetDefinition();
+	CopyEffectInstanceState(Data, EffectData);
+	return Data;
+}
+
+FGMCAbilityEffectInstanceData UGMCAbilityEffect::GetInstanceData() const
+{
+	FGMCAbilityEffectInstanceData InstanceData(GetClass(), EffectData);
+	if (DefinitionOverrides)
+	{
+		InstanceData.DefinitionOverrides.InitializeAs<FGMCAbilityEffectData>(*DefinitionOverrides);
+	}
+	return InstanceData;
+}
+
+void UGMCAbilityEffect::BeginEffectInstance()
 {
-	EffectData = InitializationData;
-	
 	OwnerAbilityComponent = EffectData.OwnerAbilityComponent;
 	
 	if (OwnerAbilityComponent == nullptr)
@@ -30,29 +349,22 @@ void UGMCAbilityEffect::InitializeEffect(FGMCAbilityEffectData InitializationDat
 	}
 	
 	ClientEffectApplicationTime = OwnerAbilityComponent->ActionTimer;
+	bScriptDynamicCondition = GetClass()->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UGMCAbilityEffect, AttributeDynamicCondition));
 
 	// If server sends times, use those
 	// Only used in the case of a non predicted effect
-	if (InitializationData.StartTime != 0)
-	{
-		EffectData.StartTime = InitializationData.StartTime;
-	}
-	else
+	if (EffectData.StartTime == 0)
 	{
-		EffectData.StartTime = OwnerAbilityComponent->ActionTimer + EffectData.Delay;
+		EffectData.StartTime = OwnerAbilityComponent->ActionTimer + GetDefinition().Delay;
 	}
 	
-	if (InitializationData.EndTime != 0)
+	if (EffectData.EndTime == 0)
 	{
-		EffectData.EndTime = InitializationData.EndTime;
-	}
-	else
-	{
-		EffectData.EndTime = EffectData.StartTime + EffectData.Duration;
+		EffectData.EndTime = EffectData.StartTime + GetDefinition().Duration;
 	}
 	
 	// Start Immediately
-	if (EffectData.Delay == 0)
+	if (GetDefinition().Delay == 0)
 	{
 		StartEffect();
 	}
@@ -64,17 +376,17 @@ void UGMCAbilityEffect::StartEffect()
 	bHasStarted = true;
 
 	// Ensure tag requirements are met before applying the effect
-	if( ( EffectData.ApplicationMustHaveTags.Num() > 0 && !DoesOwnerHaveTagFromContainer(EffectData.ApplicationMustHaveTags) ) ||
-	DoesOwnerHaveTagFromContainer(EffectData.ApplicationMustNotHaveTags) ||
-	( EffectData.MustHaveTags.Num() > 0 && !DoesOwnerHaveTagFromContainer(EffectData.MustHaveTags) ) ||
-	DoesOwnerHaveTagFromContainer(EffectData.MustNotHaveTags) )
+	if( ( GetDefinition().ApplicationMustHaveTags.Num() > 0 && !DoesOwnerHaveTagFromContainer(GetDefinition().ApplicationMustHaveTags) ) ||
+	DoesOwnerHaveTagFromContainer(GetDefinition().ApplicationMustNotHaveTags) ||
+	( GetDefinition().MustHaveTags.Num() > 0 && !DoesOwnerHaveTagFromContainer(GetDefinition().MustHaveTags) ) ||
+	DoesOwnerHaveTagFromContainer(GetDefinition().MustNotHaveTags) )
 	{
 		EndEffect();
 		return;
 	}
 	
 	// Effect Query
-	if (!EffectData.ActivationQuery.IsEmpty() && !EffectData.ActivationQuery.Matches(OwnerAbilityComponent->GetActiveTags()))
+	if (!GetDefinition().ActivationQuery.IsEmpty() && !GetDefinition().ActivationQuery.Matches(OwnerAbilityComponent->GetActiveTags()))
 		{
 		EndEffect();
 		return;
@@ -82,27 +394,27 @@ void UGMCAbilityEffect::StartEffect()
 
 	AddTagsToOwner();
 	AddAbilitiesToOwner();
-	EndActiveAbilitiesFromOwner(EffectData.CancelAbilityOnActivation);
+	EndActiveAbilitiesFromOwner(GetDefinition().CancelAbilityOnActivation);
 
-	EndActiveAbilitiesByDefinitionQuery(EffectData.EndAbilityOnActivationQuery);
+	EndActiveAbilitiesByDefinitionQuery(GetDefinition().EndAbilityOnActivationQuery);
 
 	bHasAppliedEffect = true;
 
 	OwnerAbilityComponent->OnEffectApplied.Broadcast(this);
 
 	// Instant effects modify base value and end instantly
-	if (EffectData.EffectType == EGMASEffectType::Instant
-		|| EffectData.EffectType == EGMASEffectType::Persistent
-		|| (EffectData.EffectType == EGMASEffectType::Periodic && EffectData.bPeriodicFirstTick))
+	if (GetDefinition().EffectType == EGMASEffectType::Instant
+		|| GetDefinition().EffectType == EGMASEffectType::Persistent
+		|| (GetDefinition().EffectType == EGMASEffectType::Periodic && GetDefinition().bPeriodicFirstTick))
 	{
-		for (int i = 0; i < EffectData.Modifiers.Num(); i++)
+		for (int i = 0; i < GetDefinition().Modifiers.Num(); i++)
 		{
-			FGMCAttributeModifier ModCpy = EffectData.Modifiers[i];
+			FGMCAttributeModifier ModCpy = GetDefinition().Modifiers[i];
 			ModCpy.InitModifier(this, OwnerAbilityComponent->ActionTimer, i, IsEffectModifiersRegisterInHistory(), 1.f);
 			OwnerAbilityComponent->ApplyAbilityAttributeModifier(ModCpy);
 		}
 
-		if (EffectData.EffectType == EGMASEffectType::Instant)
+		if (GetDefinition().EffectType == EGMASEffectType::Instant)
 		{
 			EndEffect();
 		}
@@ -133,19 +445,19 @@ void UGMCAbilityEffect::EndEffect()
 		// If the effect is not an instant effect, we need to negate the modifiers
 	if (IsEffectModifiersRegisterInHistory())
 	{
-		for (int i = 0; i < EffectData.Modifiers.Num(); i++)
+		for (int i = 0; i < GetDefinition().Modifiers.Num(); i++)
 		{
-			if (const FAttribute* Attribute = OwnerAbilityComponent->GetAttributeByTag(EffectData.Modifiers[i].AttributeTag))
+			if (const FAttribute* Attribute = OwnerAbilityComponent->GetAttributeByTag(GetDefinition().Modifiers[i].AttributeTag))
 			{
 				Attribute->RemoveTemporalModifier(i, this);
 			}
 		}
 	}
 	
-	EndActiveAbilitiesByDefinitionQuery(EffectData.EndAbilityOnEndQuery);
+	EndActiveAbilitiesByDefinitionQuery(GetDefinition().EndAbilityOnEndQuery);
 
-	EndActiveAbilitiesFromOwner(EffectData.CancelAbilityOnEnd);
-	RemoveTagsFromOwner(EffectData.bPreserveGrantedTagsIfMultiple);
+	EndActiveAbilitiesFromOwner(GetDefinition().CancelAbilityOnEnd);
+	RemoveTagsFromOwner(GetDefinition().bPreserveGrantedTagsIfMultiple);
 	RemoveAbilitiesFromOwner();
 	
 	OwnerAbilityComponent->OnEffectRemoved.Broadcast(this);
@@ -163,10 +475,10 @@ void UGMCAbilityEffect::BeginDestroy() {
 		for (TTuple<int, UGMCAbilityEffect*> Effect : OwnerAbilityComponent->GetActiveEffects())
 		{
 			if (Effect.Value == this) {
-				UE_LOG(LogGMCAbilitySystem, Error, TEXT("Effect %s is still in the active effect list of %s"), *Effect.Value->EffectData.EffectTag.ToString(), *OwnerAbilityComponent->GetOwner()->GetName());
+				UE_LOG(LogGMCAbilitySystem, Error, TEXT("Effect %s is still in the active effect list of %s"), *Effect.Value->GetDefinition().EffectTag.ToString(), *OwnerAbilityComponent->GetOwner()->GetName());
 				
 				if (!bCompleted) {
-					UE_LOG(	LogGMCAbilitySystem, Error, TEXT("Effect %s is being destroyed without being completed"), *Effect.Value->EffectData.EffectTag.ToString());
+					UE_LOG(	LogGMCAbilitySystem, Error, TEXT("Effect %s is being destroyed without being completed"), *Effect.Value->GetDefinition().EffectTag.ToString());
 					EndEffect();
 				}
 				
@@ -184,8 +496,8 @@ void UGMCAbilityEffect::Tick(float DeltaTime)
 	// Aherys : I'm not sure if this is correct. Sometime this is GC. We need to catch why, and when.
 	if (bCompleted || IsUnreachable()) {
 		if (IsUnreachable()) {
-			UE_LOG(LogGMCAbilitySystem, Error, TEXT("Effect is unreachable : %s"), *EffectData.EffectTag.ToString());
-			ensureMsgf(false, TEXT("Effect is being ticked after being completed or GC : %s"), *EffectData.EffectTag.ToString());
+			UE_LOG(LogGMCAbilitySystem, Error, TEXT("Effect is unreachable : %s"), *GetDefinition().EffectTag.ToString());
+			ensureMsgf(false, TEXT("Effect is being ticked after being completed or GC : %s"), *GetDefinition().EffectTag.ToString());
 		}
 		return;
 	}
@@ -194,33 +506,33 @@ void UGMCAbilityEffect::Tick(float DeltaTime)
 	TickEvent(DeltaTime);
 	
 	// Ensure tag requirements are met before applying the effect
-	if( (EffectData.MustHaveTags.Num() > 0 && !DoesOwnerHaveTagFromContainer(EffectData.MustHaveTags) ) ||
-		DoesOwnerHaveTagFromContainer(EffectData.MustNotHaveTags) )
+	if( (GetDefinition().MustHaveTags.Num() > 0 && !DoesOwnerHaveTagFromContainer(GetDefinition().MustHaveTags) ) ||
+		DoesOwnerHaveTagFromContainer(GetDefinition().MustNotHaveTags) )
 	{
 		EndEffect();
 	}
 
 	// query to maintain effect
-	if ( !EffectData.MustMaintainQuery.IsEmpty() && EffectData.MustMaintainQuery.Matches(OwnerAbilityComponent->GetActiveTags()))
+	if ( !GetDefinition().MustMaintainQuery.IsEmpty() && GetDefinition().MustMaintainQuery.Matches(OwnerAbilityComponent->GetActiveTags()))
 	{
 		EndEffect();
 	}
 
 	
-	if (!IsPaused() && CurrentState == EGMASEffectState::Started && AttributeDynamicCondition())
+	if (!IsPaused() && CurrentState == EGMASEffectState::Started && CheckDynamicConditions())
 	{
-		if (EffectData.EffectType == EGMASEffectType::Ticking) {
+		if (GetDefinition().EffectType == EGMASEffectType::Ticking) {
 		// If there's a period, check to see if it's time to tick
 
-			for (int i = 0; i < EffectData.Modifiers.Num(); i++) {
-				FGMCAttributeModifier Modifier = EffectData.Modifiers[i];
+			for (int i = 0; i < GetDefinition().Modifiers.Num(); i++) {
+				FGMCAttributeModifier Modifier = GetDefinition().Modifiers[i];
 				Modifier.InitModifier(this, OwnerAbilityComponent->ActionTimer, i, IsEffectModifiersRegisterInHistory(), DeltaTime);
 				OwnerAbilityComponent->ApplyAbilityAttributeModifier(Modifier);
 			} // End for each modifier
 
 			
 		} // End Ticking
-		else if (EffectData.EffectType == EGMASEffectType::Periodic)
+		else if (GetDefinition().EffectType == EGMASEffectType::Periodic)
 		{
 			
 			
@@ -228,15 +540,15 @@ void UGMCAbilityEffect::Tick(float DeltaTime)
 			float PreviousElapsedTime = CurrentElapsedTime - OwnerAbilityComponent->GMCMovementComponent->GetMoveDeltaTime();
 			PreviousElapsedTime = FMath::Max(PreviousElapsedTime, 0.f); // Ensure we don't go negative
 
-			int32 PreviousPeriod = FMath::TruncToInt(PreviousElapsedTime / EffectData.PeriodicInterval);
-			int32 CurrentPeriod =	FMath::TruncToInt(CurrentElapsedTime / EffectData.PeriodicInterval);
+			int32 PreviousPeriod = FMath::TruncToInt(PreviousElapsedTime / GetDefinition().PeriodicInterval);
+			int32 CurrentPeriod =	FMath::TruncToInt(CurrentElapsedTime / GetDefinition().PeriodicInterval);
 			
 			if (CurrentPeriod > PreviousPeriod) {
 				int32 NumTickToApply = CurrentPeriod - PreviousPeriod;
 				
 				for (int i = 0; i < NumTickToApply; i++) {
-					for (int y = 0; y < EffectData.Modifiers.Num(); y++) {
-						FGMCAttributeModifier Modifier = EffectData.Modifiers[y];
+					for (int y = 0; y < GetDefinition().Modifiers.Num(); y++) {
+						FGMCAttributeModifier Modifier = GetDefinition().Modifiers[y];
 						Modifier.InitModifier(this, OwnerAbilityComponent->ActionTimer, y, IsEffectModifiersRegisterInHistory(), 1.f);
 						OwnerAbilityComponent->ApplyAbilityAttributeModifier(Modifier);
 					}
@@ -279,6 +591,69 @@ bool UGMCAbilityEffect::AttributeDynamicCondition_Implementation() const {
 	return true;
 }
 
+bool UGMCAbilityEffect::CheckDynamicConditions()
+{
+	if (DynamicConditions.Num() > 0)
+	{
+		bool bPassed = DynamicConditionCombine == EGMCEffectConditionCombine::All;
+		for (FGMCEffectDynamicCondition& Condition : DynamicConditions)
+		{
+			if (EvaluateDynamicCondition(Condition) != bPassed)
+			{
+				bPassed = !bPassed;
+				break;
+			}
+		}
+		if (!bPassed) return false;
+	}
+
+	// Skip the script VM entirely unless a Blueprint actually overrides the event.
+	return bScriptDynamicCondition ? AttributeDynamicCondition() : AttributeDynamicCondition_Implementation();
+}
+
+bool UGMCAbilityEffect::EvaluateDynamicCondition(FGMCEffectDynamicCondition& Condition) const
+{
+	switch (Condition.Type)
+	{
+	case EGMCEffectConditionType::Attribute:
+		{
+			const FAttribute* Attribute = OwnerAbilityComponent->GetAttributeByTag(Condition.AttributeTag, Condition.CachedAttributeSlot);
+			if (!Attribute)
+			{
+				if (!Condition.bWarnedMissingAttribute)
+				{
+					UE_LOG(LogGMCAbilitySystem, Warning, TEXT("Effect %s has a dynamic condition on missing attribute %s"),
+						*GetDefinition().EffectTag.ToString(), *Condition.AttributeTag.ToString());
+					Condition.bWarnedMissingAttribute = true;
+				}
+				return false;
+			}
+
+			switch (Condition.Comparison)
+			{
+			case EGMCConditionComparison::Greater: return Attribute->Value > Condition.Value;
+			case EGMCConditionComparison::GreaterOrEqual: return Attribute->Value >= Condition.Value;
+			case EGMCConditionComparison::Less: return Attribute->Value < Condition.Value;
+			case EGMCConditionComparison::LessOrEqual: return Attribute->Value <= Condition.Value;
+			case EGMCConditionComparison::Equal: return FMath::IsNearlyEqual(Attribute->Value, Condition.Value);
+			case EGMCConditionComparison::NotEqual: return !FMath::IsNearlyEqual(Attribute->Value, Condition.Value);
+			}
+			return false;
+		}
+	case EGMCEffectConditionType::HasAnyTags:
+		return DoesOwnerHaveTagFromContainer(Condition.Tags);
+	case EGMCEffectConditionType::HasAllTags:
+		for (const FGameplayTag& Tag : Condition.Tags)
+		{
+			if (!OwnerAbilityComponent->HasActiveTag(Tag)) return false;
+		}
+		return true;
+	case EGMCEffectConditionType::HasNoTags:
+		return !DoesOwnerHaveTagFromContainer(Condition.Tags);
+	}
+	return true;
+}
+
 
 void UGMCAbilityEffect::PeriodTick()
 {
@@ -301,12 +676,12 @@ void UGMCAbilityEffect::UpdateState(EGMASEffectState State, bool Force)
 
 bool UGMCAbilityEffect::IsPaused()
 {
-	return DoesOwnerHaveTagFromContainer(EffectData.PauseEffect);
+	return DoesOwnerHaveTagFromContainer(GetDefinition().PauseEffect);
 }
 
 bool UGMCAbilityEffect::IsEffectModifiersRegisterInHistory() const
 {
-	return EffectData.EffectType != EGMASEffectType::Instant && EffectData.bNegateEffectAtEnd;
+	return GetDefinition().EffectType != EGMASEffectType::Instant && GetDefinition().bNegateEffectAtEnd;
 }
 
 float UGMCAbilityEffect::ProcessCustomModifier(const TSubclassOf<UGMCAttributeModifierCustom_Base>& MCClass, const FAttribute* Attribute)
@@ -340,7 +715,7 @@ void UGMCAbilityEffect::GetOwnerActor(AActor*& OutOwnerActor) const
 
 void UGMCAbilityEffect::AddTagsToOwner()
 {
-	for (const FGameplayTag Tag : EffectData.GrantedTags)
+	for (const FGameplayTag Tag : GetDefinition().GrantedTags)
 	{
 		OwnerAbilityComponent->AddActiveTag(Tag);
 	}
@@ -350,8 +725,8 @@ void UGMCAbilityEffect::RemoveTagsFromOwner(bool bPreserveOnMultipleInstances)
 {
 	if (bPreserveOnMultipleInstances)
 	{
-		if (EffectData.EffectTag.IsValid()) {
-			TArray<UGMCAbilityEffect*> ActiveEffect = OwnerAbilityComponent->GetActiveEffectsByTag(EffectData.EffectTag);
+		if (GetDefinition().EffectTag.IsValid()) {
+			TArray<UGMCAbilityEffect*> ActiveEffect = OwnerAbilityComponent->GetActiveEffectsByTag(GetDefinition().EffectTag);
 			
 			if (ActiveEffect.Num() > 1) {
 				return;
@@ -365,7 +740,7 @@ void UGMCAbilityEffect::RemoveTagsFromOwner(bool bPreserveOnMultipleInstances)
 
 
 	
-	for (const FGameplayTag Tag : EffectData.GrantedTags)
+	for (const FGameplayTag Tag : GetDefinition().GrantedTags)
 	{
 		OwnerAbilityComponent->RemoveActiveTag(Tag);
 	}
@@ -373,7 +748,7 @@ void UGMCAbilityEffect::RemoveTagsFromOwner(bool bPreserveOnMultipleInstances)
 
 void UGMCAbilityEffect::AddAbilitiesToOwner()
 {
-	for (const FGameplayTag Tag : EffectData.GrantedAbilities)
+	for (const FGameplayTag Tag : GetDefinition().GrantedAbilities)
 	{
 		OwnerAbilityComponent->GrantAbilityByTag(Tag);
 	}
@@ -381,7 +756,7 @@ void UGMCAbilityEffect::AddAbilitiesToOwner()
 
 void UGMCAbilityEffect::RemoveAbilitiesFromOwner()
 {
-	for (const FGameplayTag Tag : EffectData.GrantedAbilities)
+	for (const FGameplayTag Tag : GetDefinition().GrantedAbilities)
 	{
 		OwnerAbilityComponent->RemoveGrantedAbilityByTag(Tag);
 	}
@@ -396,7 +771,7 @@ void UGMCAbilityEffect::EndActiveAbilitiesFromOwner(const FGameplayTagContainer&
 	}
 }
 
-bool UGMCAbilityEffect::DoesOwnerHaveTagFromContainer(FGameplayTagContainer& TagContainer) const
+bool UGMCAbilityEffect::DoesOwnerHaveTagFromContainer(const FGameplayTagContainer& TagContainer) const
 {
 	for (const FGameplayTag Tag : TagContainer)
 	{
@@ -410,14 +785,14 @@ bool UGMCAbilityEffect::DoesOwnerHaveTagFromContainer(FGameplayTagContainer& Tag
 
 bool UGMCAbilityEffect::DuplicateEffectAlreadyApplied()
 {
-	if (EffectData.EffectTag == FGameplayTag::EmptyTag)
+	if (GetDefinition().EffectTag == FGameplayTag::EmptyTag)
 	{
 		return false;
 	}
 	
 	for (const TPair<int, UGMCAbilityEffect*> Effect : OwnerAbilityComponent->GetActiveEffects())
 	{
-		if (Effect.Value->EffectData.EffectTag == this->EffectData.EffectTag && Effect.Value->bHasStarted)
+		if (Effect.Value->GetDefinition().EffectTag == GetDefinition().EffectTag && Effect.Value->bHasStarted)
 		{
 			return true;
 		}
@@ -438,7 +813,7 @@ void UGMCAbilityEffect::CheckState()
 			}
 			break;
 		case EGMASEffectState::Started:
-			if (EffectData.Duration != 0 && OwnerAbilityComponent->ActionTimer >= EffectData.EndTime)
+			if (GetDefinition().Duration != 0 && OwnerAbilityComponent->ActionTimer >= EffectData.EndTime)
 			{
 				EndEffect();
 			}
@@ -457,17 +832,17 @@ void UGMCAbilityEffect::EndActiveAbilitiesByDefinitionQuery(FGameplayTagQuery En
 	int NumCancelled = OwnerAbilityComponent->EndAbilitiesByQuery(EndAbilityOnActivationViaDefinitionQuery);
 
 	UE_LOG(LogGMCAbilitySystem, Verbose, TEXT("Effect %s cancelled %d ability(ies) via EffectDefinition query."),
-		*EffectData.EffectTag.ToString(), NumCancelled);
+		*GetDefinition().EffectTag.ToString(), NumCancelled);
 }
 
 void UGMCAbilityEffect::ModifyMustMaintainQuery(const FGameplayTagQuery& NewQuery)
 {
-	EffectData.MustMaintainQuery = NewQuery;
+	GetMutableDefinition().MustMaintainQuery = NewQuery;
 	UE_LOG(LogGMCAbilitySystem, Verbose, TEXT("MustMainQuery modified: %s"), *NewQuery.GetDescription());
 }
 
 void UGMCAbilityEffect::ModifyEndAbilitiesOnEndQuery(const FGameplayTagQuery& NewQuery)
 {
-	EffectData.EndAbilityOnEndQuery = NewQuery;
+	GetMutableDefinition().EndAbilityOnEndQuery = NewQuery;
 	UE_LOG(LogGMCAbilitySystem, Verbose, TEXT("EndAbilityOnEndViaDefinitionQuery modified: %s"), *NewQuery.GetDescription());
 }
@@ -1 +1,372 @@
 ﻿#include "Utility/GMASBoundQueue.h"
+
+#include "UObject/CoreNet.h"
+
+namespace
+{
+	// Signed deltas are zigzag encoded so that small negative values pack as small as small positive ones.
+	void SerializeRelativeId(FArchive& Ar, int32& Id, int32 BaseId)
+	{
+		const int64 Delta = static_cast<int64>(Id) - BaseId;
+		uint64 Packed = Ar.IsSaving() ? (static_cast<uint64>(Delta) << 1) ^ static_cast<uint64>(Delta >> 63) : 0;
+		Ar.SerializeIntPacked64(Packed);
+		if (Ar.IsLoading())
+		{
+			Id = static_cast<int32>(BaseId + static_cast<int64>((Packed >> 1) ^ (~(Packed & 1) + 1)));
+		}
+	}
+
+	enum EHeaderFields : uint8
+	{
+		HasTag = 1 << 0,
+		HasClassNetId = 1 << 1,
+		HasClassName = 1 << 2,
+		HasPayloadIds = 1 << 3,
+		HasPayload = 1 << 4,
+		HasGracePeriod = 1 << 5,
+		HasExtraFlags = 1 << 6,
+	};
+	constexpr uint32 NumHeaderFieldBits = 7;
+	constexpr uint32 NumOperationTypeBits = 3;
+	constexpr uint32 MaxNetPayloadIds = 1024;
+	constexpr uint32 MaxNetBatchOperations = 1024;
+}
+
+bool FGMASBoundQueueRPCHeader::NetSerializeRelativeTo(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess, int32 BaseOperationId)
+{
+	bOutSuccess = true;
+
+	uint8 Fields = 0;
+	if (Ar.IsSaving())
+	{
+		Fields |= Tag.IsValid() ? HasTag : 0;
+		Fields |= ItemClassNetId != FGMASClassRegistry::InvalidNetId ? HasClassNetId : 0;
+		Fields |= ItemClassName != NAME_None ? HasClassName : 0;
+		Fields |= PayloadIds.Ids.Num() > 0 ? HasPayloadIds : 0;
+		Fields |= InstancedPayload.IsValid() ? HasPayload : 0;
+		Fields |= RPCGracePeriodSeconds != FGMASBoundQueueRPCHeader().RPCGracePeriodSeconds ? HasGracePeriod : 0;
+		Fields |= ExtraFlags != 0 ? HasExtraFlags : 0;
+	}
+	Ar.SerializeBits(&Fields, NumHeaderFieldBits);
+
+	Ar.SerializeBits(&OperationTypeRaw, NumOperationTypeBits);
+	SerializeRelativeId(Ar, OperationId, BaseOperationId);
+
+	if (Fields & HasTag)
+	{
+		bool bTagSuccess = true;
+		Tag.NetSerialize_Packed(Ar, Map, bTagSuccess);
+		bOutSuccess &= bTagSuccess;
+	}
+	else if (Ar.IsLoading())
+	{
+		Tag = FGameplayTag::EmptyTag;
+	}
+
+	uint32 PackedClassNetId = ItemClassNetId;
+	if (Fields & HasClassNetId)
+	{
+		Ar.SerializeIntPacked(PackedClassNetId);
+	}
+	if (Ar.IsLoading())
+	{
+		ItemClassNetId = (Fields & HasClassNetId) ? static_cast<uint16>(PackedClassNetId) : FGMASClassRegistry::InvalidNetId;
+	}
+
+	if (Fields & HasClassName)
+	{
+		UPackageMap::StaticSerializeName(Ar, ItemClassName);
+	}
+	else if (Ar.IsLoading())
+	{
+		ItemClassName = NAME_None;
+	}
+
+	if (Fields & HasPayloadIds)
+	{
+		uint32 NumIds = PayloadIds.Ids.Num();
+		Ar.SerializeIntPacked(NumIds);
+		if (Ar.IsLoading())
+		{
+			if (NumIds > MaxNetPayloadIds)
+			{
+				Ar.SetError();
+				bOutSuccess = false;
+				return false;
+			}
+			PayloadIds.Ids.SetNum(NumIds);
+		}
+
+		// Payload IDs are usually allocated close together, and close to the operation ID.
+		int32 PreviousId = OperationId;
+		for (int32& Id : PayloadIds.Ids)
+		{
+			SerializeRelativeId(Ar, Id, PreviousId);
+			PreviousId = Id;
+		}
+	}
+	else if (Ar.IsLoading())
+	{
+		PayloadIds.Ids.Reset();
+	}
+
+	if (Fields & HasPayload)
+	{
+		bool bPayloadSuccess = true;
+		InstancedPayload.NetSerialize(Ar, Map, bPayloadSuccess);
+		bOutSuccess &= bPayloadSuccess;
+	}
+	else if (Ar.IsLoading())
+	{
+		InstancedPayload.Reset();
+	}
+
+	if (Fields & HasGracePeriod)
+	{
+		uint32 QuantizedGracePeriod = FMath::Max(FMath::RoundToInt(RPCGracePeriodSeconds / GracePeriodResolution), 0);
+		Ar.SerializeIntPacked(QuantizedGracePeriod);
+		if (Ar.IsLoading())
+		{
+			RPCGracePeriodSeconds = QuantizedGracePeriod * GracePeriodResolution;
+		}
+	}
+	else if (Ar.IsLoading())
+	{
+		RPCGracePeriodSeconds = FGMASBoundQueueRPCHeader().RPCGracePeriodSeconds;
+	}
+
+	if (Fields & HasExtraFlags)
+	{
+		Ar << ExtraFlags;
+	}
+	else if (Ar.IsLoading())
+	{
+		ExtraFlags = 0;
+	}
+
+	if (Ar.IsError())
+	{
+		bOutSuccess = false;
+	}
+
+	return true;
+}
+
+void FGMASBoundQueueRPCHeader::AssignFrom(const FGMASBoundQueueRPCHeader& Other)
+{
+	OperationId = Other.OperationId;
+	OperationTypeRaw = Other.OperationTypeRaw;
+	Tag = Other.Tag;
+	ItemClassNetId = Other.ItemClassNetId;
+	ItemClassName = Other.ItemClassName;
+	PayloadIds.Ids = Other.PayloadIds.Ids;
+	RPCGracePeriodSeconds = Other.RPCGracePeriodSeconds;
+	ExtraFlags = Other.ExtraFlags;
+
+	// Copying the instanced struct wholesale would free and reallocate its memory; copy into it instead when the
+	// payload type matches, which it nearly always does within a queue.
+	const UScriptStruct* PayloadStruct = Other.InstancedPayload.GetScriptStruct();
+	if (PayloadStruct && PayloadStruct == InstancedPayload.GetScriptStruct())
+	{
+		PayloadStruct->CopyScriptStruct(InstancedPayload.GetMutableMemory(), Other.InstancedPayload.GetMemory());
+	}
+	else
+	{
+		InstancedPayload = Other.InstancedPayload;
+	}
+}
+
+bool FGMASBoundQueueOperationBatch::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = true;
+
+	uint32 NumOperations = Operations.Num();
+	Ar.SerializeIntPacked(NumOperations);
+	if (Ar.IsLoading())
+	{
+		if (NumOperations > MaxNetBatchOperations)
+		{
+			Ar.SetError();
+			bOutSuccess = false;
+			return false;
+		}
+		Operations.SetNum(NumOperations);
+	}
+
+	int32 PreviousOperationId = 0;
+	for (FGMASBoundQueueRPCHeader& Operation : Operations)
+	{
+		bool bOperationSuccess = true;
+		Operation.NetSerializeRelativeTo(Ar, Map, bOperationSuccess, PreviousOperationId);
+		bOutSuccess &= bOperationSuccess;
+		PreviousOperationId = Operation.OperationId;
+	}
+
+	return true;
+}
+
+bool FGMASBoundQueueAckWindow::Add(int32 Id, bool& bOutDroppedAcks)
+{
+	bOutDroppedAcks = false;
+	if (IsEmpty())
+	{
+		BaseId = Id;
+		Bits[0] = 1;
+		return true;
+	}
+
+	int64 Offset = static_cast<int64>(Id) - BaseId;
+	if (Offset < 0)
+	{
+		// Older than anything we hold; make room below, as long as that doesn't push the newest ack out.
+		if (GetHighestBit() - Offset >= NumBits) return false;
+
+		ShiftUp(static_cast<int32>(-Offset));
+		BaseId = Id;
+		Offset = 0;
+	}
+	else if (Offset >= NumBits)
+	{
+		// Newer than the window covers; drop the oldest acks to make room.
+		bOutDroppedAcks = GetLowestBit() < Offset - NumBits + 1;
+		ShiftDown(static_cast<int32>(FMath::Min<int64>(Offset - NumBits + 1, NumBits)));
+		BaseId = Id - (NumBits - 1);
+		if (IsEmpty())
+		{
+			BaseId = Id;
+		}
+		else
+		{
+			Compact();
+		}
+		Offset = static_cast<int64>(Id) - BaseId;
+	}
+
+	Bits[Offset / 64] |= 1ull << (Offset % 64);
+	return true;
+}
+
+void FGMASBoundQueueAckWindow::ExpireBefore(int32 MinId)
+{
+	if (MinId <= BaseId) return;
+
+	ShiftDown(static_cast<int32>(FMath::Min<int64>(static_cast<int64>(MinId) - BaseId, NumBits)));
+	BaseId = MinId;
+	Compact();
+}
+
+bool FGMASBoundQueueAckWindow::IsEmpty() const
+{
+	for (const uint64 Word : Bits)
+	{
+		if (Word != 0) return false;
+	}
+	return true;
+}
+
+void FGMASBoundQueueAckWindow::Reset()
+{
+	BaseId = 0;
+	FMemory::Memzero(Bits);
+}
+
+bool FGMASBoundQueueAckWindow::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = true;
+
+	uint32 PackedBaseId = static_cast<uint32>(BaseId);
+	Ar.SerializeIntPacked(PackedBaseId);
+
+	// Trailing empty words aren't sent.
+	uint32 NumUsedWords = 0;
+	if (Ar.IsSaving())
+	{
+		const int32 HighestBit = GetHighestBit();
+		NumUsedWords = HighestBit == INDEX_NONE ? 0 : HighestBit / 64 + 1;
+	}
+	Ar.SerializeIntPacked(NumUsedWords);
+
+	if (Ar.IsLoading())
+	{
+		if (NumUsedWords > NumWords)
+		{
+			Ar.SetError();
+			bOutSuccess = false;
+			return false;
+		}
+
+		BaseId = static_cast<int32>(PackedBaseId);
+		FMemory::Memzero(Bits);
+	}
+
+	for (uint32 Word = 0; Word < NumUsedWords; Word++)
+	{
+		Ar.SerializeIntPacked64(Bits[Word]);
+	}
+
+	return true;
+}
+
+int32 FGMASBoundQueueAckWindow::GetLowestBit() const
+{
+	for (int32 Word = 0; Word < NumWords; Word++)
+	{
+		if (Bits[Word] != 0)
+		{
+			return Word * 64 + static_cast<int32>(FMath::CountTrailingZeros64(Bits[Word]));
+		}
+	}
+	return INDEX_NONE;
+}
+
+int32 FGMASBoundQueueAckWindow::GetHighestBit() const
+{
+	for (int32 Word = NumWords - 1; Word >= 0; Word--)
+	{
+		if (Bits[Word] != 0)
+		{
+			return Word * 64 + 63 - static_cast<int32>(FMath::CountLeadingZeros64(Bits[Word]));
+		}
+	}
+	return INDEX_NONE;
+}
+
+void FGMASBoundQueueAckWindow::ShiftDown(int32 NumBitsToShift)
+{
+	if (NumBitsToShift <= 0) return;
+
+	const int32 WordShift = NumBitsToShift / 64;
+	const int32 BitShift = NumBitsToShift % 64;
+	for (int32 Word = 0; Word < NumWords; Word++)
+	{
+		const int32 Source = Word + WordShift;
+		const uint64 Low = Source < NumWords ? Bits[Source] : 0;
+		const uint64 High = Source + 1 < NumWords ? Bits[Source + 1] : 0;
+		Bits[Word] = BitShift == 0 ? Low : (Low >> BitShift) | (High << (64 - BitShift));
+	}
+}
+
+void FGMASBoundQueueAckWindow::ShiftUp(int32 NumBitsToShift)
+{
+	if (NumBitsToShift <= 0) return;
+
+	const int32 WordShift = NumBitsToShift / 64;
+	const int32 BitShift = NumBitsToShift % 64;
+	for (int32 Word = NumWords - 1; Word >= 0; Word--)
+	{
+		const int32 Source = Word - WordShift;
+		const uint64 High = Source >= 0 ? Bits[Source] : 0;
+		const uint64 Low = Source - 1 >= 0 ? Bits[Source - 1] : 0;
+		Bits[Word] = BitShift == 0 ? High : (High << BitShift) | (Low >> (64 - BitShift));
+	}
+}
+
+void FGMASBoundQueueAckWindow::Compact()
+{
+	const int32 LowestBit = GetLowestBit();
+	if (LowestBit > 0)
+	{
+		ShiftDown(LowestBit);
+		BaseId += LowestBit;
+	}
+}
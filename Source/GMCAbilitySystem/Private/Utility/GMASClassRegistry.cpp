@@ -0,0 +1,77 @@
+﻿#include "Utility/GMASClassRegistry.h"
+
+#include "GMCAbilitySystem.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Misc/Crc.h"
+
+void FGMASClassRegistry::Build(TArray<FSoftObjectPath> ClassPaths)
+{
+	Reset();
+
+	ClassPaths.RemoveAll([](const FSoftObjectPath& Path) { return Path.IsNull(); });
+	ClassPaths.Sort([](const FSoftObjectPath& A, const FSoftObjectPath& B) { return A.ToString() < B.ToString(); });
+
+	TArray<FSoftObjectPath> UnloadedPaths;
+	for (const FSoftObjectPath& Path : ClassPaths)
+	{
+		if (NetIdsByPath.Contains(Path)) continue;
+
+		if (Classes.Num() >= MAX_uint16 - 1)
+		{
+			UE_LOG(LogGMCAbilitySystem, Warning, TEXT("Class registry is full; %s will be sent by path."), *Path.ToString());
+			continue;
+		}
+
+		Classes.Emplace(Path);
+		NetIdsByPath.Add(Path, static_cast<uint16>(Classes.Num()));
+		Hash = FCrc::StrCrc32(*Path.ToString(), Hash);
+
+		if (!Path.ResolveObject())
+		{
+			UnloadedPaths.Add(Path);
+		}
+	}
+
+	if (UnloadedPaths.Num() > 0 && UAssetManager::IsInitialized())
+	{
+		PreloadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(UnloadedPaths);
+	}
+}
+
+void FGMASClassRegistry::Reset()
+{
+	Classes.Reset();
+	NetIdsByPath.Reset();
+	NetIdsByClass.Reset();
+	PreloadHandle.Reset();
+	Hash = 0;
+	bPeerMatches = false;
+}
+
+uint16 FGMASClassRegistry::GetNetId(const UClass* Class) const
+{
+	if (!Class || Classes.Num() == 0 || !bPeerMatches) return InvalidNetId;
+
+	if (const uint16* NetId = NetIdsByClass.Find(Class))
+	{
+		return *NetId;
+	}
+
+	const uint16* NetId = NetIdsByPath.Find(FSoftObjectPath(Class));
+	return NetIdsByClass.Add(Class, NetId ? *NetId : InvalidNetId);
+}
+
+UClass* FGMASClassRegistry::GetClass(uint16 NetId) const
+{
+	if (!Classes.IsValidIndex(NetId - 1)) return nullptr;
+
+	const TSoftClassPtr<UObject>& ClassPtr = Classes[NetId - 1];
+	if (UClass* Class = ClassPtr.Get())
+	{
+		return Class;
+	}
+
+	UE_LOG(LogGMCAbilitySystem, Verbose, TEXT("Class %s was needed before its preload finished; loading synchronously."), *ClassPtr.ToString());
+	return ClassPtr.LoadSynchronous();
+}
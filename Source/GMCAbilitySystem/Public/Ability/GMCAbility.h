@@ -18,6 +18,51 @@ enum class EAbilityState : uint8
 	Ended
 };
 
+// Why an ability can't be activated right now; see UGMC_AbilitySystemComponent::CanActivateAbility.
+UENUM(BlueprintType)
+enum class EGMCAbilityActivationFailure : uint8
+{
+	None,
+	// No granted input tag maps to the ability
+	NotGranted,
+	// Already running, and multiple instances aren't allowed
+	AlreadyActive,
+	Cooldown,
+	// A running ability blocks it, through BlockOtherAbility or its own BlockedByOtherAbility
+	BlockedByAbility,
+	MissingRequiredTag,
+	// An ActivationBlockedTags tag or the ActivationQuery
+	BlockedByTag,
+	Cost
+};
+
+UENUM(BlueprintType)
+enum class EGMCAbilityInstancingPolicy : uint8
+{
+	// A new (or pooled) instance per activation, ticked until it ends.
+	InstancedPerActivation,
+	// Runs on the class default object and ends within its activation; see ActivateNonInstanced.
+	NonInstanced
+};
+
+// Everything a non-instanced ability knows about the activation it's running.
+USTRUCT(BlueprintType)
+struct FGMCAbilityActivationContext
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "GMCAbilitySystem")
+	TObjectPtr<UGMC_AbilitySystemComponent> AbilityComponent { nullptr };
+
+	UPROPERTY(BlueprintReadOnly, Category = "GMCAbilitySystem")
+	int32 AbilityID { -1 };
+
+	UPROPERTY(BlueprintReadOnly, Category = "GMCAbilitySystem")
+	FGMCAbilityData AbilityData;
+
+	UPROPERTY(BlueprintReadOnly, Category = "GMCAbilitySystem")
+	TObjectPtr<const UInputAction> InputAction { nullptr };
+};
 
 // Forward Declarations
 class UGMC_AbilitySystemComponent;
@@ -131,6 +176,11 @@ public:
 	UPROPERTY(EditAnywhere, Category = "GMCAbilitySystem")
 	float CooldownTime;
 
+	// How many uses can be stored up. Each use starts recharging a charge over CooldownTime, one at a time, and the
+	// ability is on cooldown only while it has no charges left.
+	UPROPERTY(EditAnywhere, Category = "GMCAbilitySystem", meta=(ClampMin="1", UIMin="1"))
+	int32 MaxCharges{1};
+
 	// If true, the ability will apply the Cooldown when activated
 	// If false, the ability will NOT apply the Cooldown when the ability begins
 	// You can still apply the cooldown manually with CommitAbilityCooldown or CommitAbilityCostAndCooldown
@@ -141,12 +191,49 @@ public:
 	// the queuing) of an ability will fail if the ability already is active.
 	UPROPERTY(EditAnywhere, Category = "GMCAbilitySystem")
 	bool bAllowMultipleInstances {false};
+
+	// NonInstanced abilities check, activate and end in a single call on the class default object: no instance is
+	// created, nothing is added to the active abilities and nothing ticks. Only for abilities with no per-activation
+	// state and no tasks.
+	UPROPERTY(EditDefaultsOnly, Category = "GMCAbilitySystem")
+	EGMCAbilityInstancingPolicy InstancingPolicy { EGMCAbilityInstancingPolicy::InstancedPerActivation };
+
+	// Activate a NonInstanced ability; called on the class default object. Runs the same cooldown, blocking, cost and
+	// PreExecuteCheckEvent checks as an instanced activation, then ActivateNonInstancedEvent, and if that succeeds
+	// commits the cooldown and cost, ends abilities matching BlockOtherAbilitiesQuery and cancels conflicting abilities.
+	virtual bool ActivateNonInstanced(const FGMCAbilityActivationContext& Context) const;
+
+	// Whether a cooldown or a running ability currently stops this ability activating on AbilityComponent; either
+	// may pass within a few moves. Called on the class default object.
+	bool IsActivationTemporarilyBlocked(const UGMC_AbilitySystemComponent* AbilityComponent) const;
+
+	// The activation logic of a NonInstanced ability. Return false to abort the activation without committing it.
+	// This runs on the class default object, whose GetWorld() returns nullptr, so nodes needing a world context have
+	// to get it from Context.AbilityComponent. The same goes for PreExecuteCheckEvent, which has no owner component.
+	UFUNCTION(BlueprintNativeEvent, meta=(DisplayName="Activate Non-Instanced"), Category="GMCAbilitySystem|Ability")
+	bool ActivateNonInstancedEvent(const FGMCAbilityActivationContext& Context) const;
+
+	// Reuse ended instances of this ability from the component's pool instead of creating a new one per activation.
+	// Worth enabling for abilities activated in rapid succession; Blueprint variables are reset to their defaults
+	// between uses, anything else needs resetting in ResetAbility / On Reset Ability. That includes Instanced
+	// properties: a pooled instance keeps the same subobjects, with whatever state its last use left them in.
+	UPROPERTY(EditDefaultsOnly, Category = "GMCAbilitySystem")
+	bool bPoolInstances {false};
+
+	// Return a pooled instance to its just-constructed state, ready for another Execute. Overrides must call Super.
+	virtual void ResetAbility();
+
+	UFUNCTION(BlueprintImplementableEvent, meta=(DisplayName="On Reset Ability"), Category="GMCAbilitySystem|Ability")
+	void ResetAbilityEvent();
 	
 	// Check to see if affected attributes in the AbilityCost would still be >= 0 after committing the cost
 	// Delta time can be required if the cost is time based.
 	UFUNCTION(BlueprintPure, Category = "GMCAbilitySystem")
 	virtual bool CanAffordAbilityCost(float DeltaTime = 1.f) const;
 
+	// As CanAffordAbilityCost, against any component; safe to call on the class default object.
+	bool CanAffordAbilityCostOn(const UGMC_AbilitySystemComponent* AbilityComponent, float DeltaTime) const;
+
 	// Apply the effects in AbilityCost and (Re-)apply the CooldownTime of this ability
 	// Warning : Will apply CooldownTime regardless of already being on cooldown
 	UFUNCTION(BlueprintCallable, Category = "GMCAbilitySystem")
@@ -154,6 +241,7 @@ public:
 	
 	// (Re-)Apply the CooldownTime of this ability
 	// Warning : Will apply CooldownTime regardless of already being on cooldown
+	// With MaxCharges above 1, this uses up a charge instead
 	UFUNCTION(BlueprintCallable, Category = "GMCAbilitySystem")
 	virtual void CommitAbilityCooldown();
 	
@@ -239,9 +327,6 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "GMCAbilitySystem")
 	bool bActivateOnMovementTick = false; 
 
-	UFUNCTION()
-	void ServerConfirm();
-
 	UFUNCTION()
 	void SetPendingEnd();
 	
@@ -262,14 +347,10 @@ private:
 	int AbilityID = -1;
 	int TaskIDCounter = -1;
 
-	bool bServerConfirmed = false;
-
 	bool bEndPending = false;
 
-	float ClientStartTime;
-	
-	// How long to wait for server to confirm ability before cancelling on client
-	float ServerConfirmTimeout = 1.f;
+	// Whether our tags are counted in the component's running ability tags.
+	bool bRunningTagsRegistered = false;
 
 	/** List of currently active tasks, do not modify directly */
 	UPROPERTY()
@@ -280,6 +361,11 @@ private:
 
 	bool IsOnCooldown() const;
 
+	// Shared between instanced and non-instanced activation, against whichever component is activating us.
+	bool IsBlockedByActiveAbility(const UGMC_AbilitySystemComponent* AbilityComponent) const;
+	void CancelConflictingAbilitiesOn(UGMC_AbilitySystemComponent* AbilityComponent) const;
+	void EndAbilitiesBlockedByQueryOn(UGMC_AbilitySystemComponent* AbilityComponent) const;
+
 public:
 	FString ToString() const{
 		return FString::Printf(TEXT("[name: %s] [Tag %s] (%s) | NumTasks %d"), *GetName().Left(30), *AbilityTag.ToString(), *EnumToString(AbilityState), RunningTasks.Num());
@@ -39,3 +39,31 @@ class GMCABILITYSYSTEM_API UGMCAbilityMapData : public UPrimaryDataAsset{
 public:
 	const TArray<FAbilityMapData>& GetAbilityMapData() const { return AbilityMapData; }
 };
+
+// A flattened, read-only ability map: each input tag resolves to a contiguous run of ability classes. Components
+// built from the same list of ability map assets share one table; any runtime change builds a new one.
+class GMCABILITYSYSTEM_API FGMCAbilityMapTable
+{
+public:
+	static TSharedRef<const FGMCAbilityMapTable> Build(const TMap<FGameplayTag, FAbilityMapData>& AbilityMap);
+
+	// The table shared by every component whose ability map was built from exactly these assets. AbilityMap is only
+	// read if no live table exists yet.
+	static TSharedRef<const FGMCAbilityMapTable> GetShared(const TArray<TObjectPtr<UGMCAbilityMapData>>& AbilityMapAssets,
+		const TMap<FGameplayTag, FAbilityMapData>& AbilityMap);
+
+	// The abilities for an input tag, or an empty view. Valid for as long as the table is.
+	TConstArrayView<TSubclassOf<UGMCAbility>> Find(const FGameplayTag& InputTag) const;
+
+	bool Contains(const FGameplayTag& InputTag) const { return Spans.Contains(InputTag); }
+
+private:
+	struct FSpan
+	{
+		int32 Start = 0;
+		int32 Num = 0;
+	};
+
+	TMap<FGameplayTag, FSpan> Spans;
+	TArray<TSubclassOf<UGMCAbility>> Abilities;
+};
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Ability/GMCAbility.h"
+#include "Effects/GMCAbilityEffect.h"
+#include "GMCAbilityTestTypes.generated.h"
+
+// Classes for automation tests to configure through their own class defaults, leaving the base classes untouched.
+
+UCLASS(NotBlueprintable, NotBlueprintType, HideDropdown, Transient)
+class UGMCTestAbility : public UGMCAbility
+{
+	GENERATED_BODY()
+};
+
+UCLASS(NotBlueprintable, NotBlueprintType, HideDropdown, Transient)
+class UGMCTestCostEffect : public UGMCAbilityEffect
+{
+	GENERATED_BODY()
+
+public:
+	// The modifiers of the class definition, to set up on the class defaults.
+	TArray<FGMCAttributeModifier>& GetMutableModifiers() { return GetMutableDefinition().Modifiers; }
+};
@@ -55,6 +55,10 @@ struct FGMCAttributeModifier
 		// If isn't ticking, set DeltaTime to 1.f !
 		void InitModifier(UGMCAbilityEffect* Effect, double InActionTimer, int InApplicationIdx, bool bInRegisterInHistory = false, float
 		                  InDeltaTime = 1.f);
+
+		// As InitModifier, for evaluating a modifier of an effect that isn't applied to AbilityComponent (e.g. an ability
+		// cost on its class defaults): attributes are read from AbilityComponent rather than the effect's owner.
+		void InitModifierFor(const UGMC_AbilitySystemComponent* AbilityComponent, UGMCAbilityEffect* Effect, double InActionTimer, float InDeltaTime = 1.f);
 		
 		UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Attribute", meta = (Categories="Attribute"))
 		FGameplayTag AttributeTag;
@@ -77,6 +81,9 @@ struct FGMCAttributeModifier
 
 		double ActionTimer {0.0};
 
+		// Set by InitModifierFor; the component attributes are read from, instead of the source effect's owner.
+		TWeakObjectPtr<const UGMC_AbilitySystemComponent> EvaluationComponent{nullptr};
+
 		int ApplicationIndex{0};
 
 		UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "GMCAbilitySystem")
@@ -126,5 +133,36 @@ struct FGMCAttributeModifier
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "GMCAbilitySystem",
 		meta=(EditCondition = "Op == EModifierType::AddPercentageAttributeSum", EditConditionHides, DisplayAfter = "ValueType"))
 		FGameplayTagContainer Attributes;
+
+	// Compares the authored definition of the modifier, ignoring the runtime state set by InitModifier.
+	bool operator==(const FGMCAttributeModifier& Other) const
+	{
+		return AttributeTag == Other.AttributeTag && ValueType == Other.ValueType && ValueAsAttribute == Other.ValueAsAttribute
+			&& Op == Other.Op && CustomModifierClass == Other.CustomModifierClass && MetaTags == Other.MetaTags
+			&& ModifierValue == Other.ModifierValue && X == Other.X && Y == Other.Y && XAsAttribute == Other.XAsAttribute
+			&& YAsAttribute == Other.YAsAttribute && XAttribute == Other.XAttribute && YAttribute == Other.YAttribute
+			&& Attributes == Other.Attributes;
+	}
+
+	bool operator!=(const FGMCAttributeModifier& Other) const { return !(*this == Other); }
+
+	// Only the authored definition is sent; runtime state is rebuilt by InitModifier on the receiving side.
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+private:
+
+	// The component attributes are read from, or null if there is none to read.
+	const UGMC_AbilitySystemComponent* GetEvaluationComponent() const;
+
+	float GetAttributeValue(const FGameplayTag& Tag) const;
 	
+};
+
+template<>
+struct TStructOpsTypeTraits<FGMCAttributeModifier> : public TStructOpsTypeTraitsBase2<FGMCAttributeModifier>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
 };
\ No newline at end of file
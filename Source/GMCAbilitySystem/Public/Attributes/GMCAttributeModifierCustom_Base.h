@@ -43,6 +43,8 @@ class GMCABILITYSYSTEM_API UGMCAttributeModifierCustom_Base : public UObject
 
 		//  Designed to be overridden in C++ or Blueprint, this function will be called to calculate the final value of the attribute modifier.
 		// If override in C++, don't call super to avoid calling the Blueprint event and pay the performance cost of the Blueprint call.
+		// When checking whether an ability cost is affordable, SourceEffect is the cost's class default object, with no
+		// owner component, and Attribute is read from the component being checked.
 	virtual float Calculate(UGMCAbilityEffect* SourceEffect, const FAttribute* Attribute);
 
 protected:
@@ -0,0 +1,119 @@
+#include "Ability/GMCAbility.h"
+#include "Ability/GMCAbilityTestTypes.h"
+#include "Components/GMCAbilityComponent.h"
+#include "Effects/GMCAbilityEffect.h"
+#include "Misc/AutomationTest.h"
+#include "NativeGameplayTags.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Test_Ability, "GMAS.Test.Ability");
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Test_Blocker, "GMAS.Test.Blocker");
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Test_Required, "GMAS.Test.Required");
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Test_Blocked, "GMAS.Test.Blocked");
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Test_Input, "GMAS.Test.Input");
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Test_Stamina, "GMAS.Test.Stamina");
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Test_StaminaCost, "GMAS.Test.StaminaCost");
+
+	FAttribute MakeTestAttribute(const FGameplayTag& Tag, float InitialValue)
+	{
+		FAttribute Attribute;
+		Attribute.Tag = Tag;
+		Attribute.InitialValue = InitialValue;
+		Attribute.Init();
+		return Attribute;
+	}
+}
+
+// Each EGMCAbilityActivationFailure reason, reported by CanActivateAbility for a component set up to hit it. The test
+// ability and cost classes are configured through their class defaults, reset at the start of every run.
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCanActivateAbilityTest, "UE5.Marketplace.DeepWorlds_GMCAbilitySystem.Source.GMCAbilitySystem.Public.Components.CanActivateAbility", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCanActivateAbilityTest::RunTest(const FString& Parameters)
+{
+	const TSubclassOf<UGMCAbility> AbilityClass = UGMCTestAbility::StaticClass();
+	UGMCTestAbility* AbilityCDO = GetMutableDefault<UGMCTestAbility>();
+	UGMCTestCostEffect* CostCDO = GetMutableDefault<UGMCTestCostEffect>();
+
+	AbilityCDO->AbilityTag = TAG_Test_Ability;
+	AbilityCDO->ActivationRequiredTags.Reset();
+	AbilityCDO->ActivationBlockedTags.Reset();
+	AbilityCDO->BlockedByOtherAbility.Reset();
+	AbilityCDO->AbilityCost = nullptr;
+	CostCDO->GetMutableModifiers().Reset();
+
+	UGMC_AbilitySystemComponent* Component = NewObject<UGMC_AbilitySystemComponent>(GetTransientPackage());
+	Component->ActionTimer = 0.0;
+
+	EGMCAbilityActivationFailure Failure;
+
+	TestFalse(TEXT("No ability class can't activate"), Component->CanActivateAbility(nullptr, Failure));
+	TestTrue(TEXT("No ability class is NotGranted"), Failure == EGMCAbilityActivationFailure::NotGranted);
+	TestFalse(TEXT("An ungranted input tag can't activate"), Component->CanActivateAbilityByInputTag(TAG_Test_Input, Failure));
+	TestTrue(TEXT("An ungranted input tag is NotGranted"), Failure == EGMCAbilityActivationFailure::NotGranted);
+
+	TestTrue(TEXT("An unrestricted ability can activate"), Component->CanActivateAbility(AbilityClass, Failure));
+	TestTrue(TEXT("An unrestricted ability reports no failure"), Failure == EGMCAbilityActivationFailure::None);
+
+	// Activation tags
+	AbilityCDO->ActivationRequiredTags.AddTag(TAG_Test_Required);
+	Component->CanActivateAbility(AbilityClass, Failure);
+	TestTrue(TEXT("A missing required tag is MissingRequiredTag"), Failure == EGMCAbilityActivationFailure::MissingRequiredTag);
+	Component->AddActiveTag(TAG_Test_Required);
+
+	AbilityCDO->ActivationBlockedTags.AddTag(TAG_Test_Blocked);
+	Component->AddActiveTag(TAG_Test_Blocked);
+	Component->CanActivateAbility(AbilityClass, Failure);
+	TestTrue(TEXT("An active blocked tag is BlockedByTag"), Failure == EGMCAbilityActivationFailure::BlockedByTag);
+	Component->RemoveActiveTag(TAG_Test_Blocked);
+	TestTrue(TEXT("Satisfied activation tags allow activation"), Component->CanActivateAbility(AbilityClass, Failure));
+
+	// Cooldown
+	Component->ConsumeChargeForAbility(TAG_Test_Ability, 10.f);
+	Component->CanActivateAbility(AbilityClass, Failure);
+	TestTrue(TEXT("A running cooldown is Cooldown"), Failure == EGMCAbilityActivationFailure::Cooldown);
+	Component->ActionTimer = 20.0;
+	TestTrue(TEXT("A finished cooldown allows activation"), Component->CanActivateAbility(AbilityClass, Failure));
+
+	// Running abilities
+	UGMCAbility* Blocker = NewObject<UGMCAbility>(GetTransientPackage());
+	Blocker->AbilityTag = TAG_Test_Blocker;
+	Component->AddRunningAbilityTags(Blocker);
+	AbilityCDO->BlockedByOtherAbility.AddTag(TAG_Test_Blocker);
+	Component->CanActivateAbility(AbilityClass, Failure);
+	TestTrue(TEXT("A running ability in BlockedByOtherAbility is BlockedByAbility"), Failure == EGMCAbilityActivationFailure::BlockedByAbility);
+	Component->RemoveRunningAbilityTags(Blocker);
+	TestTrue(TEXT("An ended blocking ability allows activation"), Component->CanActivateAbility(AbilityClass, Failure));
+
+	// Cost, including a modifier whose value comes from another attribute on the queried component.
+	Component->BoundAttributes.AddAttribute(MakeTestAttribute(TAG_Test_Stamina, 5.f));
+	Component->BoundAttributes.AddAttribute(MakeTestAttribute(TAG_Test_StaminaCost, -10.f));
+	FGMCAttributeModifier& CostModifier = CostCDO->GetMutableModifiers().AddDefaulted_GetRef();
+	CostModifier.AttributeTag = TAG_Test_Stamina;
+	CostModifier.ValueType = EGMCAttributeModifierType::AMT_Value;
+	CostModifier.ModifierValue = -10.f;
+	AbilityCDO->AbilityCost = UGMCTestCostEffect::StaticClass();
+	Component->CanActivateAbility(AbilityClass, Failure);
+	TestTrue(TEXT("A cost the attribute can't cover is Cost"), Failure == EGMCAbilityActivationFailure::Cost);
+
+	CostCDO->GetMutableModifiers()[0].ModifierValue = -5.f;
+	TestTrue(TEXT("A cost the attribute covers allows activation"), Component->CanActivateAbility(AbilityClass, Failure));
+
+	CostCDO->GetMutableModifiers()[0].ValueType = EGMCAttributeModifierType::AMT_Attribute;
+	CostCDO->GetMutableModifiers()[0].ValueAsAttribute = TAG_Test_StaminaCost;
+	Component->CanActivateAbility(AbilityClass, Failure);
+	TestTrue(TEXT("An attribute-valued cost is read from the queried component"), Failure == EGMCAbilityActivationFailure::Cost);
+	AbilityCDO->AbilityCost = nullptr;
+
+	// Already active
+	TestTrue(TEXT("The ability activates"), Component->TryActivateAbility(AbilityClass));
+	Component->CanActivateAbility(AbilityClass, Failure);
+	TestTrue(TEXT("A running single-instance ability is AlreadyActive"), Failure == EGMCAbilityActivationFailure::AlreadyActive);
+	Component->EndAbilitiesByTag(TAG_Test_Ability);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,255 @@
+#include "Components/GMCAbilityComponent.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// A client activates abilities on a move, is corrected to the server's state from before that move, and replays it.
+// Active abilities aren't rolled back by the correction, so the replay has to find and re-record them.
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGMCBoundAbilityStateReplayTest, "UE5.Marketplace.DeepWorlds_GMCAbilitySystem.Source.GMCAbilitySystem.Public.Components.BoundAbilityStateReplay", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGMCBoundAbilityStateReplayTest::RunTest(const FString& Parameters)
+{
+	// Ability IDs to the name of the ability class running under them.
+	TMap<int32, FName> ActiveAbilities;
+	auto IsInUse = [&ActiveAbilities](int32 Id) { return ActiveAbilities.Contains(Id); };
+	auto IsAbility = [&ActiveAbilities](FName AbilityName)
+	{
+		return [&ActiveAbilities, AbilityName](int32 Id) { return ActiveAbilities.FindRef(Id) == AbilityName; };
+	};
+
+	FGMCBoundAbilityState ServerState;
+	FGMCBoundAbilityState ClientState;
+
+	// An earlier move, which both sides agree on.
+	const int32 OlderId = FGMASIdAllocator::Allocate(5.0, IsInUse);
+	ActiveAbilities.Add(OlderId, TEXT("Sprint"));
+	ServerState.ActivatedAbilities.Add(OlderId);
+	ClientState.ActivatedAbilities.Add(OlderId);
+	const FGMCBoundAbilityState CorrectedState = ServerState;
+
+	// The move being replayed activates two abilities; the second probes past the first's ID.
+	constexpr double MoveTimer = 10.0;
+	const int32 DashId = FGMASIdAllocator::Allocate(MoveTimer, IsInUse);
+	ActiveAbilities.Add(DashId, TEXT("Dash"));
+	const int32 FireId = FGMASIdAllocator::Allocate(MoveTimer, IsInUse);
+	ActiveAbilities.Add(FireId, TEXT("Fire"));
+	for (FGMCBoundAbilityState* State : { &ServerState, &ClientState })
+	{
+		State->ActivatedAbilities.Add(DashId);
+		State->ActivatedAbilities.Add(FireId);
+	}
+
+	// Corrected to before the move, the activations read as refused until the move is replayed.
+	ClientState = CorrectedState;
+	TestTrue(TEXT("A corrected activation reads as refused before the replay"), ClientState.WasActivationRefused(DashId));
+
+	const int32 ReplayedDashId = ClientState.FindReplayedActivation(MoveTimer, IsInUse, IsAbility(TEXT("Dash")));
+	TestEqual(TEXT("The replay finds the first ability it activated"), ReplayedDashId, DashId);
+	ClientState.ActivatedAbilities.Add(ReplayedDashId);
+
+	const int32 ReplayedFireId = ClientState.FindReplayedActivation(MoveTimer, IsInUse, IsAbility(TEXT("Fire")));
+	TestEqual(TEXT("The replay finds an ability activated after another on the same move"), ReplayedFireId, FireId);
+	ClientState.ActivatedAbilities.Add(ReplayedFireId);
+
+	TestFalse(TEXT("A replayed activation isn't refused"), ClientState.WasActivationRefused(DashId) || ClientState.WasActivationRefused(FireId));
+	TestTrue(TEXT("The replayed state matches the server's, so there's no further correction"), ClientState == ServerState);
+
+	TestEqual(TEXT("An activation is only re-recorded once"), ClientState.FindReplayedActivation(MoveTimer, IsInUse, IsAbility(TEXT("Dash"))), FGMASIdAllocator::InvalidId);
+	TestEqual(TEXT("An ability the move didn't activate isn't found"), ClientState.FindReplayedActivation(MoveTimer, IsInUse, IsAbility(TEXT("Sprint"))), FGMASIdAllocator::InvalidId);
+	TestEqual(TEXT("Nothing is found on a move that activated nothing"), ClientState.FindReplayedActivation(MoveTimer + 1.0, IsInUse, IsAbility(TEXT("Dash"))), FGMASIdAllocator::InvalidId);
+
+	// Activations recorded outside a move are appended on the next one.
+	FGMCBoundAbilityState Pending;
+	const int32 AncillaryId = FGMASIdAllocator::Allocate(MoveTimer + 0.5, IsInUse);
+	Pending.ActivatedAbilities.Add(AncillaryId);
+	Pending.EndedAbilities.Add(DashId, 0);
+	ClientState.Append(Pending, FGMASIdAllocator::GetSeed(MoveTimer + 1.0));
+	Pending.Reset();
+	TestTrue(TEXT("Pending activations are appended"), ClientState.ActivatedAbilities.Contains(AncillaryId) && ClientState.ActivatedAbilities.Contains(FireId));
+	TestTrue(TEXT("Pending ends are appended"), ClientState.EndedAbilities.Contains(DashId));
+	TestEqual(TEXT("Pending ends are stamped with the move they're appended on"), ClientState.EndedAbilities.Entries[0].EndedAt, FGMASIdAllocator::GetSeed(MoveTimer + 1.0));
+	TestTrue(TEXT("Pending state is empty once reset"), Pending.ActivatedAbilities.IsEmpty() && Pending.EndedAbilities.IsEmpty());
+
+	return true;
+}
+
+// Five minutes of moves with abilities and effects starting and ending throughout: expiry keeps the state, and so
+// what's sent with every move, small, while ends stay visible for a lifetime after they happen.
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGMCBoundAbilityStateExpiryTest, "UE5.Marketplace.DeepWorlds_GMCAbilitySystem.Source.GMCAbilitySystem.Public.Components.BoundAbilityStateExpiry", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGMCBoundAbilityStateExpiryTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 MovesPerSecond = 60;
+	constexpr int32 NumMoves = 5 * 60 * MovesPerSecond;
+	constexpr double AbilitySeconds = 30.0;
+	constexpr double EffectSeconds = 2.0;
+
+	// IDs to when they're due to end.
+	TMap<int32, double> ActiveAbilities;
+	TMap<int32, double> ActiveEffects;
+	auto IsInUse = [&](int32 Id) { return ActiveAbilities.Contains(Id) || ActiveEffects.Contains(Id); };
+
+	FGMCBoundAbilityState State;
+	int32 MaxBytes = 0;
+	int32 LongLivedId = FGMASIdAllocator::InvalidId;
+	double LongLivedEndTimer = 0.0;
+
+	for (int32 Move = 0; Move < NumMoves; Move++)
+	{
+		const double MoveTimer = static_cast<double>(Move) / MovesPerSecond;
+		const int32 EndedAt = FGMASIdAllocator::GetSeed(MoveTimer);
+		State.Expire(MoveTimer);
+
+		for (auto It = ActiveAbilities.CreateIterator(); It; ++It)
+		{
+			if (It.Value() > MoveTimer) continue;
+			State.EndedAbilities.Add(It.Key(), EndedAt);
+			if (It.Key() == LongLivedId)
+			{
+				LongLivedEndTimer = MoveTimer;
+			}
+			It.RemoveCurrent();
+		}
+		for (auto It = ActiveEffects.CreateIterator(); It; ++It)
+		{
+			if (It.Value() > MoveTimer) continue;
+			State.EndedEffects.Add(It.Key(), EndedAt);
+			It.RemoveCurrent();
+		}
+
+		// An ability every second and an effect every half second.
+		if (Move % MovesPerSecond == 0)
+		{
+			const int32 AbilityId = FGMASIdAllocator::Allocate(MoveTimer, IsInUse);
+			ActiveAbilities.Add(AbilityId, MoveTimer + AbilitySeconds);
+			State.ActivatedAbilities.Add(AbilityId);
+			if (LongLivedId == FGMASIdAllocator::InvalidId)
+			{
+				LongLivedId = AbilityId;
+			}
+		}
+		if (Move % (MovesPerSecond / 2) == 0)
+		{
+			const int32 EffectId = FGMASIdAllocator::Allocate(MoveTimer, IsInUse);
+			ActiveEffects.Add(EffectId, MoveTimer + EffectSeconds);
+		}
+
+		FBitWriter Writer(0, true);
+		bool bSuccess = false;
+		State.NetSerialize(Writer, nullptr, bSuccess);
+		MaxBytes = FMath::Max(MaxBytes, static_cast<int32>((Writer.GetNumBits() + 7) / 8));
+
+		if (LongLivedEndTimer == MoveTimer)
+		{
+			TestTrue(TEXT("An ability ended long after it began is recorded"), State.EndedAbilities.Contains(LongLivedId));
+			TestFalse(TEXT("An ability older than the lifetime isn't refused"), State.WasActivationRefused(LongLivedId));
+		}
+		else if (LongLivedEndTimer > 0.0 && MoveTimer - LongLivedEndTimer < FGMCBoundAbilityState::LifetimeSeconds - 0.1)
+		{
+			TestTrue(TEXT("An end stays recorded for its lifetime"), State.EndedAbilities.Contains(LongLivedId));
+		}
+	}
+
+	TestFalse(TEXT("An end is forgotten after its lifetime"), State.EndedAbilities.Contains(LongLivedId));
+	TestTrue(FString::Printf(TEXT("The state stays small (%d bytes at most)"), MaxBytes), MaxBytes <= 256);
+
+	FBitWriter Writer(0, true);
+	bool bSuccess = false;
+	State.NetSerialize(Writer, nullptr, bSuccess);
+	FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+	FGMCBoundAbilityState Received;
+	Received.NetSerialize(Reader, nullptr, bSuccess);
+	TestTrue(TEXT("The state round trips"), bSuccess && !Reader.IsError() && Received == State);
+
+	return true;
+}
+
+// A client activates an ability between moves. The server puts it on a later move than the client did, so the client
+// is corrected to states without it before one with it; and a correction to before the move it was appended to
+// replays that move. Neither ends the ability, while an activation the server never records is ended.
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGMCBoundAbilityStateCorrectionTest, "UE5.Marketplace.DeepWorlds_GMCAbilitySystem.Source.GMCAbilitySystem.Public.Components.BoundAbilityStateCorrection", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGMCBoundAbilityStateCorrectionTest::RunTest(const FString& Parameters)
+{
+	const TSubclassOf<UGMCAbility> AbilityClass = UGMCAbility::StaticClass();
+
+	// The parts of GenPredictionTick which touch the bound state.
+	auto RunMove = [](UGMC_AbilitySystemComponent* Component, double MoveTimer, bool bReplaying)
+	{
+		Component->ActionTimer = MoveTimer;
+		Component->bInPredictionTick = true;
+		Component->BeginBoundAbilityStateMove(bReplaying);
+		Component->bInPredictionTick = false;
+	};
+	auto ActivateBetweenMoves = [this, &AbilityClass](UGMC_AbilitySystemComponent* Component)
+	{
+		TestTrue(TEXT("The ability activates between moves"), Component->TryActivateAbility(AbilityClass));
+		TArray<int> AbilityIds;
+		Component->ActiveAbilities.GenerateKeyArray(AbilityIds);
+		return AbilityIds.Num() == 1 ? AbilityIds[0] : FGMASIdAllocator::InvalidId;
+	};
+	auto IsRunning = [](UGMC_AbilitySystemComponent* Component, int32 AbilityId)
+	{
+		const UGMCAbility* Ability = Component->ActiveAbilities.FindRef(AbilityId);
+		return Ability && Ability->AbilityState != EAbilityState::Ended;
+	};
+
+	{
+		UGMC_AbilitySystemComponent* Client = NewObject<UGMC_AbilitySystemComponent>(GetTransientPackage());
+		RunMove(Client, 10.0, false);
+		const FGMCBoundAbilityState BeforeActivation = Client->GetBoundAbilityState();
+
+		const int32 AbilityId = ActivateBetweenMoves(Client);
+		RunMove(Client, 10.1, false);
+		RunMove(Client, 10.2, false);
+		TestTrue(TEXT("The client appends the activation to its next move"), Client->GetBoundAbilityState().ActivatedAbilities.Contains(AbilityId));
+
+		// Corrected to before the move the activation was appended to; replaying that move appends it again.
+		Client->GetBoundAbilityState() = BeforeActivation;
+		RunMove(Client, 10.1, true);
+		TestTrue(TEXT("Replaying a move re-appends what it took from the pending state"), Client->GetBoundAbilityState().ActivatedAbilities.Contains(AbilityId));
+		RunMove(Client, 10.2, true);
+
+		// The server handled the activation with the move after, so the client's move is corrected without it.
+		FGMCBoundAbilityState ServerState = BeforeActivation;
+		ServerState.Expire(10.1);
+		Client->GetBoundAbilityState() = ServerState;
+		RunMove(Client, 10.2, true);
+		Client->ReconcileBoundAbilityState();
+		TestTrue(TEXT("An activation the server hasn't recorded yet isn't taken as refused"), IsRunning(Client, AbilityId));
+
+		ServerState.Expire(10.2);
+		ServerState.ActivatedAbilities.Add(AbilityId);
+		Client->GetBoundAbilityState() = ServerState;
+		RunMove(Client, 12.0, false);
+		Client->ReconcileBoundAbilityState();
+		TestTrue(TEXT("An activation the server recorded on a later move is confirmed"), IsRunning(Client, AbilityId));
+	}
+
+	{
+		UGMC_AbilitySystemComponent* Client = NewObject<UGMC_AbilitySystemComponent>(GetTransientPackage());
+		RunMove(Client, 20.0, false);
+		const FGMCBoundAbilityState BeforeActivation = Client->GetBoundAbilityState();
+
+		const int32 AbilityId = ActivateBetweenMoves(Client);
+		RunMove(Client, 20.1, false);
+
+		// The server refused it, so no state it sends ever has it.
+		FGMCBoundAbilityState ServerState = BeforeActivation;
+		ServerState.Expire(20.1);
+		Client->GetBoundAbilityState() = ServerState;
+		Client->ReconcileBoundAbilityState();
+		TestTrue(TEXT("A refusal isn't acted on while the server may still record the activation"), IsRunning(Client, AbilityId));
+
+		AddExpectedError(TEXT("Ability Not Confirmed By Server"), EAutomationExpectedErrorFlags::Contains, 1);
+		RunMove(Client, 20.0 + Client->OutsideMoveConfirmTimeout + 0.1, false);
+		Client->ReconcileBoundAbilityState();
+		TestFalse(TEXT("An activation the server never records is ended"), IsRunning(Client, AbilityId));
+	}
+
+	return true;
+}
+
+#endif
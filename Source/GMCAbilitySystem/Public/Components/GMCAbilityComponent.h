@@ -3,6 +3,7 @@
 
 #include "CoreMinimal.h"
 #include "GameplayTasksComponent.h"
+#include "Algo/BinarySearch.h"
 #include "Attributes/GMCAttributes.h"
 #include "GMCMovementUtilityComponent.h"
 #include "Ability/GMCAbilityData.h"
@@ -71,6 +72,364 @@ struct FGMASQueueOperationHandle
 	int32 NetworkId { -1 };
 };
 
+USTRUCT(BlueprintType)
+struct FGMCAbilityPoolStats
+{
+	GENERATED_BODY()
+
+	// Ended instances waiting to be reused.
+	UPROPERTY(BlueprintReadOnly, Category = "GMCAbilitySystem")
+	int32 NumPooled { 0 };
+
+	// Instances created because the pool was empty.
+	UPROPERTY(BlueprintReadOnly, Category = "GMCAbilitySystem")
+	int32 NumCreated { 0 };
+
+	// Activations served from the pool.
+	UPROPERTY(BlueprintReadOnly, Category = "GMCAbilitySystem")
+	int32 NumReused { 0 };
+
+	// Ended instances discarded because the pool was full.
+	UPROPERTY(BlueprintReadOnly, Category = "GMCAbilitySystem")
+	int32 NumDiscarded { 0 };
+};
+
+// Ended instances of one ability class, kept for reuse.
+USTRUCT()
+struct FGMCAbilityPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<UGMCAbility>> Instances;
+
+	FGMCAbilityPoolStats Stats;
+};
+
+// The cooldown of one ability tag, as the ActionTimer value at which all of its charges are back. Each charge
+// recharges over RechargeTime, one at a time.
+USTRUCT()
+struct FGMCAbilityCooldown
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FGameplayTag AbilityTag;
+
+	UPROPERTY()
+	double RechargedAt { 0.0 };
+
+	UPROPERTY()
+	float RechargeTime { 0.f };
+
+	UPROPERTY()
+	int32 MaxCharges { 1 };
+
+	// Seconds until at least one charge is available.
+	float GetRemainingTime(double Now) const
+	{
+		return FMath::Max(0.f, static_cast<float>(RechargedAt - Now) - (MaxCharges - 1) * RechargeTime);
+	}
+
+	int32 GetCharges(double Now) const
+	{
+		if (RechargeTime <= 0.f) return RechargedAt > Now ? 0 : MaxCharges;
+		const int32 Recharging = FMath::CeilToInt32(static_cast<float>(RechargedAt - Now) / RechargeTime);
+		return FMath::Clamp(MaxCharges - Recharging, 0, MaxCharges);
+	}
+};
+
+// Every ability cooldown still running, bound through GMC so it is predicted and corrected with the move.
+USTRUCT()
+struct FGMCAbilityCooldownData
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FGMCAbilityCooldown> Cooldowns;
+};
+
+USTRUCT()
+struct FGMCBoundEndedId
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 Id { 0 };
+
+	// ID seed of the move it ended on.
+	UPROPERTY()
+	int32 EndedAt { 0 };
+
+	bool operator==(const FGMCBoundEndedId& Other) const { return Id == Other.Id && EndedAt == Other.EndedAt; }
+};
+
+// Ability or effect IDs which ended recently. An ID only says when its ability or effect began, which can be long
+// before it ended, so these expire by the move they ended on instead.
+USTRUCT()
+struct FGMCBoundEndedIds
+{
+	GENERATED_BODY()
+
+	// More than we'd ever expect to end within a lifetime; anything past this off the network is rejected.
+	static constexpr int32 MaxEntries = 1024;
+
+	// Sorted by ID, so that both sides compare equal whatever order they ended things in.
+	UPROPERTY()
+	TArray<FGMCBoundEndedId> Entries;
+
+	void Add(int32 Id, int32 EndedAt)
+	{
+		const int32 Index = Algo::LowerBoundBy(Entries, Id, &FGMCBoundEndedId::Id);
+		if (Entries.IsValidIndex(Index) && Entries[Index].Id == Id) return;
+		Entries.Insert(FGMCBoundEndedId { Id, EndedAt }, Index);
+	}
+
+	bool Contains(int32 Id) const
+	{
+		const int32 Index = Algo::LowerBoundBy(Entries, Id, &FGMCBoundEndedId::Id);
+		return Entries.IsValidIndex(Index) && Entries[Index].Id == Id;
+	}
+
+	// Forget everything which ended on a move seeded before MinEndedAt.
+	void ExpireBefore(int32 MinEndedAt)
+	{
+		Entries.RemoveAll([MinEndedAt](const FGMCBoundEndedId& Entry) { return Entry.EndedAt < MinEndedAt; });
+	}
+
+	bool IsEmpty() const { return Entries.IsEmpty(); }
+
+	void Reset() { Entries.Reset(); }
+
+	// IDs as steps from the one before, and end seeds, as varints.
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+	{
+		bOutSuccess = true;
+
+		uint32 NumEntries = Entries.Num();
+		Ar.SerializeIntPacked(NumEntries);
+		if (Ar.IsLoading())
+		{
+			if (NumEntries > MaxEntries)
+			{
+				Ar.SetError();
+				bOutSuccess = false;
+				return true;
+			}
+			Entries.SetNum(NumEntries);
+		}
+
+		int32 PreviousId = 0;
+		for (FGMCBoundEndedId& Entry : Entries)
+		{
+			uint32 IdStep = static_cast<uint32>(Entry.Id - PreviousId);
+			uint32 EndedAt = static_cast<uint32>(Entry.EndedAt);
+			Ar.SerializeIntPacked(IdStep);
+			Ar.SerializeIntPacked(EndedAt);
+			if (Ar.IsLoading())
+			{
+				Entry.Id = PreviousId + static_cast<int32>(IdStep);
+				Entry.EndedAt = static_cast<int32>(EndedAt);
+			}
+			PreviousId = Entry.Id;
+		}
+
+		return true;
+	}
+
+	bool operator==(const FGMCBoundEndedIds& Other) const { return Entries == Other.Entries; }
+};
+
+// Ability activations, and ability and effect ends, recorded by both client and server as they happen. Bound as
+// server-auth output: when the client's prediction disagrees it is corrected to the server's sets, which is how it
+// learns, in order with the movement stream, of activations the server refused and of ends it didn't predict.
+// Entries only need to outlive a correction, so everything older than LifetimeSeconds is expired on each move.
+USTRUCT()
+struct FGMCBoundAbilityState
+{
+	GENERATED_BODY()
+
+	// Keep this under FGMASBoundQueueAckWindow::NumBits IDs' worth of time, with room for probing, so that
+	// activations within their lifetime always fit in the window.
+	static constexpr float LifetimeSeconds = 4.f;
+
+	UPROPERTY()
+	FGMASBoundQueueAckWindow ActivatedAbilities;
+
+	UPROPERTY()
+	FGMCBoundEndedIds EndedAbilities;
+
+	UPROPERTY()
+	FGMCBoundEndedIds EndedEffects;
+
+	// Activations below this have expired from ActivatedAbilities.
+	UPROPERTY()
+	int32 OldestLiveId { 0 };
+
+	// Abilities activated before the lifetime are long since confirmed.
+	bool WasActivationRefused(int32 AbilityID) const
+	{
+		return AbilityID >= OldestLiveId && !ActivatedAbilities.Contains(AbilityID);
+	}
+
+	// Called at the start of every move, replays included, so that both sides expire the same entries on the same move.
+	void Expire(double ActionTimer)
+	{
+		if (ActionTimer <= LifetimeSeconds) return;
+
+		OldestLiveId = FGMASIdAllocator::GetSeed(ActionTimer - LifetimeSeconds);
+		ActivatedAbilities.ExpireBefore(OldestLiveId);
+		EndedAbilities.ExpireBefore(OldestLiveId);
+		EndedEffects.ExpireBefore(OldestLiveId);
+	}
+
+	// Corrections don't roll back active abilities, so a replayed move finds the abilities it activated still running.
+	// Walks the IDs the allocator probed on that move and returns the first one held by a matching ability that isn't
+	// recorded yet, or InvalidId if the move activated no such ability.
+	template<typename InUsePredicate, typename MatchPredicate>
+	int32 FindReplayedActivation(double ActionTimer, InUsePredicate&& IsInUse, MatchPredicate&& IsReplayedAbility) const
+	{
+		int32 Id = FGMASIdAllocator::GetSeed(ActionTimer);
+		for (int32 Probe = 0; Probe < FGMASIdAllocator::MaxProbes && IsInUse(Id); Probe++)
+		{
+			if (IsReplayedAbility(Id) && !ActivatedAbilities.Contains(Id)) return Id;
+			Id = FGMASIdAllocator::GetNext(Id);
+		}
+		return FGMASIdAllocator::InvalidId;
+	}
+
+	// Ends are stamped with the move they're appended on, rather than whenever they were recorded.
+	void Append(const FGMCBoundAbilityState& Other, int32 EndedAt)
+	{
+		Other.ActivatedAbilities.ForEach([this](int32 Id) { ActivatedAbilities.Add(Id); });
+		for (const FGMCBoundEndedId& Entry : Other.EndedAbilities.Entries)
+		{
+			EndedAbilities.Add(Entry.Id, EndedAt);
+		}
+		for (const FGMCBoundEndedId& Entry : Other.EndedEffects.Entries)
+		{
+			EndedEffects.Add(Entry.Id, EndedAt);
+		}
+	}
+
+	void Reset()
+	{
+		ActivatedAbilities.Reset();
+		EndedAbilities.Reset();
+		EndedEffects.Reset();
+	}
+
+	bool IsEmpty() const
+	{
+		return ActivatedAbilities.IsEmpty() && EndedAbilities.IsEmpty() && EndedEffects.IsEmpty();
+	}
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+	{
+		bool bActivatedSuccess = true;
+		bool bEndedSuccess = true;
+		bool bEffectsSuccess = true;
+		uint32 PackedOldestLiveId = static_cast<uint32>(OldestLiveId);
+		Ar.SerializeIntPacked(PackedOldestLiveId);
+		OldestLiveId = static_cast<int32>(PackedOldestLiveId);
+		ActivatedAbilities.NetSerialize(Ar, Map, bActivatedSuccess);
+		EndedAbilities.NetSerialize(Ar, Map, bEndedSuccess);
+		EndedEffects.NetSerialize(Ar, Map, bEffectsSuccess);
+		bOutSuccess = bActivatedSuccess && bEndedSuccess && bEffectsSuccess;
+		return true;
+	}
+
+	bool operator==(const FGMCBoundAbilityState& Other) const
+	{
+		return OldestLiveId == Other.OldestLiveId && ActivatedAbilities == Other.ActivatedAbilities && EndedAbilities == Other.EndedAbilities && EndedEffects == Other.EndedEffects;
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FGMCBoundAbilityState> : public TStructOpsTypeTraitsBase2<FGMCBoundAbilityState>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true,
+	};
+};
+
+// An ability input that couldn't activate anything yet, retried each move until it does or ExpiresAt passes.
+USTRUCT()
+struct FGMCBufferedAbilityInput
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FGameplayTag InputTag;
+
+	UPROPERTY()
+	TObjectPtr<const UInputAction> InputAction;
+
+	// ActionTimer value after which the input is dropped
+	UPROPERTY()
+	double ExpiresAt { 0.0 };
+};
+
+// Buffered ability inputs, at most one per input tag, bound through GMC so replays retry them on the same moves.
+USTRUCT()
+struct FGMCAbilityInputBuffer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FGMCBufferedAbilityInput> Inputs;
+};
+
+// Which of our queues a server-auth operation sent to the client belongs to.
+UENUM()
+enum class EGMASClientQueuedOperationType : uint8
+{
+	Effect,
+	Event
+};
+
+// Every server-auth effect and event operation queued for our client over a frame, in the order they were queued.
+USTRUCT()
+struct FGMASClientQueuedOperations
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FGMASBoundQueueOperationBatch Batch;
+
+	// One per operation in the batch.
+	UPROPERTY()
+	TArray<EGMASClientQueuedOperationType> Types;
+
+	void Add(const FGMASBoundQueueRPCHeader& Header, EGMASClientQueuedOperationType Type)
+	{
+		Batch.Operations.Add(Header);
+		Types.Add(Type);
+	}
+
+	int32 Num() const { return Batch.Operations.Num(); }
+
+	void Reset()
+	{
+		Batch.Operations.Reset();
+		Types.Reset();
+	}
+
+	// The batch, followed by a bit per operation for its type.
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FGMASClientQueuedOperations> : public TStructOpsTypeTraitsBase2<FGMASClientQueuedOperations>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
+
 UENUM(BlueprintType)
 enum class EGMCAbilityEffectQueueType : uint8
 {
@@ -128,6 +487,9 @@ public:
 
 	// Is this a server-only pawn (not player-controlled)?
 	bool IsServerOnly() const;
+
+	// True in standalone, or with bServerOnlyMode set: nothing we do has to be predicted, acknowledged or sent on.
+	bool IsAuthorityOnly() const { return bServerOnlyMode || GetNetMode() == NM_Standalone; }
 	
 	// Ability tags that the controller has 
 	FGameplayTagContainer GetGrantedAbilities() const { return GrantedAbilityTags; }
@@ -213,7 +575,8 @@ public:
 	TArray<FGameplayTag> GetActiveTagsByParentTag(const FGameplayTag ParentTag);
 
 	// Do not call directly on client, go through QueueAbility
-	void TryActivateAbilitiesByInputTag(const FGameplayTag& InputTag, const UInputAction* InputAction = nullptr, bool bFromMovementTick=true);
+	// Returns false if abilities for this tick were tried and every one of them was refused
+	bool TryActivateAbilitiesByInputTag(const FGameplayTag& InputTag, const UInputAction* InputAction = nullptr, bool bFromMovementTick=true);
 	
 	// Do not call directly on client, go through QueueAbility. Can be used to call server-side abilities (like AI).
 	bool TryActivateAbility(TSubclassOf<UGMCAbility> ActivatedAbility, const UInputAction* InputAction = nullptr, const FGameplayTag ActivationTag = FGameplayTag::EmptyTag);
@@ -237,9 +600,28 @@ public:
 	UFUNCTION(BlueprintCallable, DisplayName="Count Activated Ability Instances", Category="GMAS|Abilities")
 	int32 GetActiveAbilityCount(TSubclassOf<UGMCAbility> AbilityClass);
 
-	// Perform a check in every active ability against BlockOtherAbility and check if the tag provided is present
+	// Whether TryActivateAbility would get past its checks for AbilityClass right now (already active, activation
+	// tags, cooldown, running abilities, cost), and if not, the first that fails. Reads only class defaults and
+	// current state: nothing is instanced, changed or logged beyond Verbose, and the ability's own
+	// PreExecuteCheckEvent isn't run. Cheap enough for AI scoring and UI to call every frame.
+	UFUNCTION(BlueprintPure, Category="GMAS|Abilities")
+	bool CanActivateAbility(TSubclassOf<UGMCAbility> AbilityClass, EGMCAbilityActivationFailure& OutFailure) const;
+
+	// As CanActivateAbility, for the abilities an input tag would activate; true if any of them could. Fails with
+	// NotGranted if the input tag isn't granted or maps to nothing.
+	UFUNCTION(BlueprintPure, Category="GMAS|Abilities")
+	bool CanActivateAbilityByInputTag(UPARAM(meta=(Categories="Input")) FGameplayTag InputTag, EGMCAbilityActivationFailure& OutFailure) const;
+
+	// Check the tag provided against the BlockOtherAbility tags of every running ability
 	virtual bool IsAbilityTagBlocked(const FGameplayTag AbilityTag) const;
 
+	// The AbilityTag of every running ability (between BeginAbility and its end)
+	const FGameplayTagContainer& GetRunningAbilityTags() const { return RunningAbilityTags; }
+
+	// Called by abilities as they begin and end, and around changes to their BlockOtherAbility tags
+	void AddRunningAbilityTags(const UGMCAbility* Ability);
+	void RemoveRunningAbilityTags(const UGMCAbility* Ability);
+
 	UFUNCTION(BlueprintCallable, DisplayName="End Abilities (By Tag)", Category="GMAS|Abilities")
 	// End all abilities with the corresponding tag, returns the number of abilities ended
 	int EndAbilitiesByTag(FGameplayTag AbilityTag);
@@ -262,8 +644,16 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "GMCAbilitySystem")
 	void SetCooldownForAbility(const FGameplayTag AbilityTag, float CooldownTime);
 
+	// Use one charge of an ability. Abilities with a single charge just have their cooldown set to RechargeTime.
+	UFUNCTION(BlueprintCallable, Category = "GMCAbilitySystem")
+	void ConsumeChargeForAbility(const FGameplayTag AbilityTag, float RechargeTime, int32 MaxCharges = 1);
+
+	// Seconds until the ability has a charge to use
 	UFUNCTION(BlueprintPure, Category = "GMCAbilitySystem")
 	float GetCooldownForAbility(const FGameplayTag AbilityTag) const;
+
+	UFUNCTION(BlueprintPure, Category = "GMCAbilitySystem")
+	int32 GetChargesForAbility(TSubclassOf<UGMCAbility> Ability) const;
 	
 	UFUNCTION(BlueprintPure, Category = "GMCAbilitySystem")
 	float GetMaxCooldownForAbility(TSubclassOf<UGMCAbility> Ability) const;
@@ -305,6 +695,9 @@ public:
 
 	int GetNextAvailableEffectID() const;
 	bool CheckIfEffectIDQueued(int EffectID) const;
+	// The effect data that will actually be used for an effect of this class: the given data if it overrides the
+	// class definition, otherwise the class default.
+	static const FGMCAbilityEffectData& GetEffectDefinition(const TSubclassOf<UGMCAbilityEffect>& EffectClass, const FGMCAbilityEffectData& EffectData);
 	int CreateEffectOperation(TGMASBoundQueueOperation<UGMCAbilityEffect, FGMCAbilityEffectData>& OutOperation, const TSubclassOf<UGMCAbilityEffect>& Effect, const FGMCAbilityEffectData& EffectData, bool bForcedEffectId = true, EGMCAbilityEffectQueueType QueueType = EGMCAbilityEffectQueueType::Predicted);
 	int CreateSyncedEventOperation(TGMASBoundQueueOperation<UGMASSyncedEvent, FGMASSyncedEventContainer>& OutOperation, const FGMASSyncedEventContainer& EventData);
 	
@@ -360,8 +753,30 @@ public:
 	 */
 	bool ApplyAbilityEffect(TSubclassOf<UGMCAbilityEffect> EffectClass, FGMCAbilityEffectData InitializationData, EGMCAbilityEffectQueueType QueueType, int& OutEffectHandle, int& OutEffectId, UGMCAbilityEffect*& OutEffect);
 
+	/**
+	 * Applies the same effect to a batch of ability components, such as every target caught in an area of effect.
+	 * Must be called on the server, and only server-auth queue types are supported. The effect payload and its
+	 * queue operation are built once and cloned for each target, and each target's client notification is
+	 * batched into a single RPC sent on the next tick.
+	 *
+	 * No local effect handles are created; use the returned network IDs to refer to the applied effects.
+	 *
+	 * @param EffectClass The class of ability effect to add.
+	 * @param InitializationData The initialization data for the ability effect, shared by all targets.
+	 * @param Targets The ability components to apply the effect to. Null entries are skipped.
+	 * @param QueueType How to queue the effect; must be ServerAuth or ServerAuthMove.
+	 * @param OutEffectIds The effect's network ID on each target, index-matched to Targets (-1 if skipped).
+	 * @return The number of targets the effect was queued on.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GMAS|Effects", DisplayName="Apply Ability Effect To Targets")
+	int32 ApplyAbilityEffectToTargets(TSubclassOf<UGMCAbilityEffect> EffectClass, FGMCAbilityEffectData InitializationData, const TArray<UGMC_AbilitySystemComponent*>& Targets, EGMCAbilityEffectQueueType QueueType,
+		UPARAM(DisplayName="Effect Network IDs") TArray<int>& OutEffectIds);
+
 	// Do not call this directly unless you know what you are doing. Otherwise, always go through the above ApplyAbilityEffect variant!
 	UGMCAbilityEffect* ApplyAbilityEffect(UGMCAbilityEffect* Effect, FGMCAbilityEffectData InitializationData);
+
+	// As above, for an effect using its class definition; only the per-instance state is applied.
+	UGMCAbilityEffect* ApplyAbilityEffect(UGMCAbilityEffect* Effect, const FGMCAbilityEffectInstanceData& InstanceData);
 	
 	UFUNCTION(BlueprintCallable, Category="GMAS|Effects")
 	UGMCAbilityEffect* GetEffectById(const int EffectId) const;
@@ -477,7 +892,18 @@ public:
 	/** Get an Attribute using its Tag */
 	const FAttribute* GetAttributeByTag(UPARAM(meta=(Categories="Attribute")) FGameplayTag AttributeTag) const;
 
-	TMap<int, UGMCAbility*> GetActiveAbilities() const { return ActiveAbilities; }
+	/** Get an Attribute using its Tag, trying the cached slot from a previous lookup first. The slot is updated if the attribute moved. */
+	const FAttribute* GetAttributeByTag(FGameplayTag AttributeTag, int32& InOutSlot) const;
+
+	const TMap<int, UGMCAbility*>& GetActiveAbilities() const { return ActiveAbilities; }
+
+	// Usage of the instance pool for an ability class with bPoolInstances set.
+	UFUNCTION(BlueprintPure, Category="GMAS|Abilities")
+	FGMCAbilityPoolStats GetAbilityPoolStats(TSubclassOf<UGMCAbility> AbilityClass) const;
+
+	// How many ended instances of each pooled ability class are kept for reuse.
+	UPROPERTY(EditDefaultsOnly, Category="Ability", meta=(ClampMin="0", UIMin="0"))
+	int32 MaxPooledAbilitiesPerClass = 4;
 
 	// Get Attribute value (RawValue + Temporal Modifiers) by Tag
 	UFUNCTION(BlueprintPure, Category="GMAS|Attributes")
@@ -604,9 +1030,40 @@ protected:
 
 	UPROPERTY(EditDefaultsOnly, Category="Tags")
 	FGameplayTagContainer StartingTags;
+
+	// How many queued operations (ability activations, predicted effects) can ride a single move. Operations queued
+	// beyond this are sent with the following moves, in order.
+	UPROPERTY(EditDefaultsOnly, Category="Ability", meta=(ClampMin="1", UIMin="1"))
+	int32 MaxQueuedOperationsPerMove = 4;
+
+	// When more operations are queued than fit in a move, which operation types are sent first. Types left out are
+	// sent after these. Leave empty to use the default order (cancels, removals, activations, then adds).
+	UPROPERTY(EditDefaultsOnly, Category="Ability")
+	TArray<EGMASBoundQueueOperationType> QueuedOperationDrainOrder;
+
+	// How long, in seconds, an ability input that is refused by a cooldown or a blocking ability keeps being retried
+	// on the following moves. 0 disables buffering. Only abilities activated on the movement tick are buffered; other
+	// refusals (activation tags, cost, a failed pre-execution check) are final.
+	UPROPERTY(EditDefaultsOnly, Category="Ability", meta=(ClampMin="0", UIMin="0"))
+	float AbilityInputBufferTime = 0.f;
+
+	// Drop an ability input if an activation for the same input tag is already waiting to be sent.
+	UPROPERTY(EditDefaultsOnly, Category="Ability")
+	bool bDeduplicateQueuedAbilityInputs = true;
+
+	// For pawns that are never player controlled, such as AI. Only state that simulated proxies need (attributes,
+	// active tags) is bound through GMC; operation queues, cooldowns and task data are kept locally, effects and events
+	// apply without waiting on a client, and no activation or operation RPCs are sent. The effect, ability and
+	// attribute API is unchanged. Must be set on the class defaults so every machine binds the same data.
+	UPROPERTY(EditDefaultsOnly, Category="Ability")
+	bool bServerOnlyMode = false;
 	
-	// Returns the matching abilities in the AbilityMap if they have been granted
-	TArray<TSubclassOf<UGMCAbility>> GetGrantedAbilitiesByTag(FGameplayTag AbilityTag);
+	// Returns the matching abilities in the AbilityMap if they have been granted. The view is only valid until the
+	// ability map next changes; pin GetAbilityMapTable() to keep it across anything that might change it.
+	TConstArrayView<TSubclassOf<UGMCAbility>> GetGrantedAbilitiesByTag(FGameplayTag AbilityTag);
+
+	// The compiled form of AbilityMap, rebuilt on first use after the map changes.
+	TSharedRef<const FGMCAbilityMapTable> GetAbilityMapTable();
 	
 	// Sync'd containers for abilities and effects
 	FGMCAbilityData AbilityData;
@@ -628,6 +1085,29 @@ private:
 	// Map of Ability Tags to Ability Classes
 	TMap<FGameplayTag, FAbilityMapData> AbilityMap;
 
+	// Lookup table compiled from AbilityMap, shared with other components using the same AbilityMaps until either
+	// map changes at runtime. Null when it needs rebuilding.
+	TSharedPtr<const FGMCAbilityMapTable> AbilityMapTable;
+
+	// Net IDs for the ability and effect classes referenced by our defaults, used by the operation queues.
+	FGMASClassRegistry ClassRegistry;
+
+	// Register every class referenced by AbilityMaps and StartingEffects, and start preloading them.
+	void BuildClassRegistry();
+
+	// The server's ClassRegistry hash, so the owning client can tell whether their registries match.
+	UPROPERTY(ReplicatedUsing = OnRep_ServerClassRegistryHash)
+	uint32 ServerClassRegistryHash { 0 };
+
+	UFUNCTION()
+	void OnRep_ServerClassRegistryHash();
+
+	// Bound as client input, telling the server whether the client's registry matches its own.
+	bool bClassRegistryMatchesServer { false };
+
+	// Only let the registry hand out net IDs once both sides are known to have built the same one.
+	void UpdateClassRegistryPeerMatch();
+
 public:
 	// Empty the AbilityMap and remove all granted abilities from existing maps
 	UFUNCTION(BlueprintCallable, Category="GMAS|Abilities")
@@ -694,14 +1174,18 @@ private:
 	virtual UGMCAbilityEffect* ProcessOperation(const TGMASBoundQueueOperation<UGMCAbilityEffect, FGMCAbilityEffectData>& Operation);
 
 	
+	// Server-auth operations for our client are buffered and sent once per frame, as a single RPC.
 	void ClientQueueOperation(const TGMASBoundQueueOperation<UGMCAbilityEffect, FGMCAbilityEffectData>& Operation);
 	void ClientQueueOperation(const TGMASBoundQueueOperation<UGMASSyncedEvent, FGMASSyncedEventContainer>& Operation);
-	
-	UFUNCTION(Client, Reliable)
-	void RPCClientQueueEffectOperation(const FGMASBoundQueueRPCHeader& Header);
-	
+
+	FGMASClientQueuedOperations PendingClientOperations;
+	bool bClientOperationFlushScheduled { false };
+
+	void DeferClientQueueOperation(const FGMASBoundQueueRPCHeader& Header, EGMASClientQueuedOperationType Type);
+	void FlushClientQueueOperations();
+
 	UFUNCTION(Client, Reliable)
-	void RPCClientQueueEventOperation(const FGMASBoundQueueRPCHeader& Header);
+	void RPCClientQueueOperations(const FGMASClientQueuedOperations& Operations);
 
 	// Predictions of Effect state changes
 	FEffectStatePrediction EffectStatePrediction{};
@@ -710,11 +1194,66 @@ private:
 
 	UPROPERTY()
 	TMap<int, UGMCAbility*> ActiveAbilities;
-	
+
 	UPROPERTY()
-	TMap<FGameplayTag, float> ActiveCooldowns;
+	TMap<TSubclassOf<UGMCAbility>, FGMCAbilityPool> AbilityPools;
+
+	// Ref-counted unions of the ability tags and BlockOtherAbility tags of every running ability, so that activation
+	// checks are a single container query however many abilities are running.
+	TMap<FGameplayTag, int32> RunningAbilityTagCounts;
+	FGameplayTagContainer RunningAbilityTags;
+	TMap<FGameplayTag, int32> BlockedAbilityTagCounts;
+	FGameplayTagContainer BlockedAbilityTags;
+
+	// Active ability IDs indexed under their AbilityTag and each of its parents, and under their class and each of its
+	// superclasses, so lookups by tag or class only visit the abilities that match.
+	TMap<FGameplayTag, TArray<int32>> ActiveAbilityIdsByTag;
+	TMap<const UClass*, TArray<int32>> ActiveAbilityIdsByClass;
+
+	// Instances of AbilityClass (or a subclass) that haven't ended.
+	int32 CountActiveAbilities(TSubclassOf<UGMCAbility> AbilityClass) const;
+
+	// Every change to ActiveAbilities goes through these to keep the indexes in step.
+	void AddActiveAbility(int32 AbilityID, UGMCAbility* Ability);
+	void RemoveActiveAbilityIndexes(int32 AbilityID, const UGMCAbility* Ability);
+
+	// Copies the IDs out, since ending an ability can activate or end others.
+	void GetActiveAbilityIdsByTag(FGameplayTag AbilityTag, TArray<int32, TInlineAllocator<8>>& OutAbilityIds) const;
+	void GetActiveAbilityIdsByClass(TSubclassOf<UGMCAbility> AbilityClass, TArray<int32, TInlineAllocator<8>>& OutAbilityIds) const;
+
+	// A fresh or reset instance of AbilityClass, taken from its pool if it has one.
+	UGMCAbility* AcquireAbilityInstance(TSubclassOf<UGMCAbility> AbilityClass);
 
-	int GenerateAbilityID() const {return ActionTimer * 100;}
+	// Hand an ended ability back to its pool; instances of unpooled classes are left to GC.
+	void ReleaseAbilityInstance(UGMCAbility* Ability);
+	
+	// Bound through GMC. Expired entries are dropped whenever a cooldown is written.
+	FInstancedStruct CooldownData = FInstancedStruct::Make(FGMCAbilityCooldownData{});
+
+	// Bound through GMC.
+	FInstancedStruct AbilityInputBuffer = FInstancedStruct::Make(FGMCAbilityInputBuffer{});
+
+	// Buffer an input that activated nothing, or push back the expiry of the one already buffered for its tag.
+	void BufferAbilityInput(const FGameplayTag& InputTag, const UInputAction* InputAction);
+
+	// Retry buffered inputs on the movement tick, dropping those that activate, have expired or are no longer only
+	// temporarily blocked.
+	void ProcessBufferedAbilityInputs();
+
+	// Whether any movement tick ability granted for the input is refused only by a cooldown or a running ability.
+	bool IsAbilityInputTemporarilyBlocked(const FGameplayTag& InputTag);
+
+	FGMCAbilityCooldown* FindCooldown(const FGameplayTag& AbilityTag);
+	const FGMCAbilityCooldown* FindCooldown(const FGameplayTag& AbilityTag) const;
+
+	// Find or add the entry for AbilityTag, dropping any that have fully recharged.
+	FGMCAbilityCooldown& WriteCooldown(const FGameplayTag& AbilityTag);
+
+	// If multiple abilities are activated on the same move, the allocator probes past IDs already in use.
+	int GenerateAbilityID() const
+	{
+		return FGMASIdAllocator::Allocate(ActionTimer, [this](int32 Id) { return ActiveAbilities.Contains(Id); });
+	}
 	
 	// Set Attributes to either a default object or a provided TSubClassOf<UGMCAttributeSet> in BP defaults
 	// This must run before variable binding
@@ -745,15 +1284,14 @@ private:
 	// Tick active abilities, but from the ancillary tick rather than prediction
 	void TickAncillaryActiveAbilities(float DeltaTime);
 
-	// Tick ability cooldowns
-	void TickActiveCooldowns(float DeltaTime);
-
 	// Active Effects with a duration affecting this component
 	// Can be just normally replicated since if the client doesn't have them already
 	// then prediction is already out the window
 
+	// Only the compact instance state is replicated, plus the definition delta for effects applied with overrides;
+	// the client rebuilds the rest from the effect class.
 	UPROPERTY(ReplicatedUsing = OnRep_ActiveEffectsData)
-	TArray<FGMCAbilityEffectData> ActiveEffectsData;
+	TArray<FGMCAbilityEffectInstanceData> ActiveEffectsData;
 
 	// Max time a client will predict an effect without it being confirmed by the server before cancelling
 	float ClientEffectApplicationTimeout = 1.f;
@@ -761,6 +1299,9 @@ private:
 	UFUNCTION()
 	void OnRep_ActiveEffectsData();
 
+	// Register an initialized effect as active, assigning an ID if it doesn't have one yet.
+	UGMCAbilityEffect* AddActiveEffect(UGMCAbilityEffect* Effect);
+
 	// Check if any effects have been removed by the server and remove them locally
 	void CheckRemovedEffects();
 
@@ -770,7 +1311,9 @@ private:
 	UPROPERTY()
 	TMap<int, FGMASQueueOperationHandle> EffectHandles;
 
-	int GetNextAvailableEffectHandle() const;
+	FGMASHandleAllocator EffectHandleAllocator;
+
+	int GetNextAvailableEffectHandle();
 
 	UFUNCTION(BlueprintCallable, Category="GMAS|Effects")
 	void GetEffectFromHandle_BP(int EffectHandle, bool& bOutSuccess, int32& OutEffectNetworkId, UGMCAbilityEffect*& OutEffect);
@@ -783,6 +1326,8 @@ private:
 	UPROPERTY(BlueprintReadOnly, Category = "GMCAbilitySystem", meta=(AllowPrivateAccess="true"))
 	bool bInAncillaryTick = false;
 
+	bool bInPredictionTick = false;
+
 	void ServerHandlePendingEffect(float DeltaTime);
 	void ServerHandlePredictedPendingEffect(float DeltaTime);
 
@@ -799,24 +1344,42 @@ private:
 	UPROPERTY()
 	TMap<int /*ID*/, EGMCEffectAnswerState /*bServerConfirmed*/> ProcessedEffectIDs;
 
-	// Let the client know that the server has activated this ability as well
-	// Needed for the client to cancel mis-predicted abilities
-	UFUNCTION(Client, Reliable)
-	void RPCConfirmAbilityActivation(int AbilityID);
+	// Bound through GMC; replaces per-event confirm and end RPCs.
+	FInstancedStruct BoundAbilityState = FInstancedStruct::Make(FGMCBoundAbilityState{});
 
-	// Let the client know that the server has ended an ability
-	// In most cases, the client should have predicted this already,
-	// this is just for redundancy
-	UFUNCTION(Client, Reliable)
-	void RPCClientEndAbility(int AbilityID);
-	
-	// Let the client know that the server has ended an effect
-	// In most cases, the client should have predicted this already,
-	// this is just for redundancy
-	UFUNCTION(Client, Reliable)
-	void RPCClientEndEffect(int EffectID);
+	FGMCBoundAbilityState& GetBoundAbilityState() { return BoundAbilityState.GetMutable<FGMCBoundAbilityState>(); }
+
+	// Activations and ends outside the movement tick (ancillary tick abilities, server-side calls) wait here until the
+	// next move, so the bound state only ever changes within a move.
+	FGMCBoundAbilityState PendingBoundAbilityState;
+
+	// What each recent move took from PendingBoundAbilityState, by move timestamp, so that replaying the move adds it
+	// again.
+	TArray<TPair<double, FGMCBoundAbilityState>> AppendedPendingStates;
+
+	// Activations this client made outside a move, and the action timer they were made at. The server records them on
+	// whichever move it handles them with, which needn't be the move we appended them to.
+	TMap<int32, double> OutsideMoveActivations;
+
+	// How long an activation made outside a move may be missing from the bound state before it's taken as refused.
+	// Keep this under FGMCBoundAbilityState::LifetimeSeconds.
+	float OutsideMoveConfirmTimeout = 1.f;
+
+	FGMCBoundAbilityState& GetWritableBoundAbilityState()
+	{
+		return bInPredictionTick ? GetBoundAbilityState() : PendingBoundAbilityState;
+	}
+
+	// Bring the bound state up to the move at ActionTimer: expire it, then add whatever was recorded since the last
+	// move, or when replaying, whatever the move took from the pending state the first time around.
+	void BeginBoundAbilityStateMove(bool bReplaying);
+
+	// On the client, end abilities the server refused or ended and effects it ended, per the bound state.
+	void ReconcileBoundAbilityState();
 
 	friend UGMCAbilityAnimInstance;
+	friend class FGMCBoundAbilityStateCorrectionTest;
+	friend class FApplyEffectToTargetsBenchmark;
 
 public:
 	// Networked FX
@@ -0,0 +1,139 @@
+#include "Components/GMCAbilityComponent.h"
+#include "Effects/GMCAbilityEffect.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/AutomationTest.h"
+#include "Utility/GMASBoundQueue.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Compares looping ApplyAbilityEffect over 500 targets against one ApplyAbilityEffectToTargets call, both server-auth
+// so each target also defers its client send, and checks that every target ends up with exactly one operation.
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FApplyEffectToTargetsBenchmark, "UE5.Marketplace.DeepWorlds_GMCAbilitySystem.Source.GMCAbilitySystem.Public.Effects.ApplyEffectToTargetsBenchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FApplyEffectToTargetsBenchmark::RunTest(const FString& Parameters)
+{
+	using FEffectOperation = TGMASBoundQueueOperation<UGMCAbilityEffect, FGMCAbilityEffectData>;
+
+	constexpr int32 NumTargets = 500;
+	constexpr int32 NumIterations = 10;
+
+	const TSubclassOf<UGMCAbilityEffect> EffectClass = UGMCAbilityEffect::StaticClass();
+
+	// A payload with a handful of modifiers, roughly the size of a typical damage-over-time effect.
+	FGMCAbilityEffectData EffectData;
+	EffectData.Duration = 5.f;
+	EffectData.PeriodicInterval = 1.f;
+	EffectData.Modifiers.SetNum(4);
+
+	// The components need an authoritative owner, and a world so client sends are deferred to the next tick rather
+	// than flushed straight away; it never ticks, so they stay pending for us to check.
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	AActor* Owner = World->SpawnActor<AActor>();
+
+	auto MakeComponent = [Owner]()
+	{
+		UGMC_AbilitySystemComponent* Component = NewObject<UGMC_AbilitySystemComponent>(Owner);
+		Component->ActionTimer = 1.0;
+		return Component;
+	};
+
+	// Exactly one queued operation, carrying EffectId, with exactly one client send of that same operation.
+	auto HasSingleOperation = [](const UGMC_AbilitySystemComponent* Target, int32 EffectId)
+	{
+		const TArray<FEffectOperation>& Queued = Target->QueuedEffectOperations.GetQueuedRPCOperations();
+		const TArray<FGMASBoundQueueRPCHeader>& Pending = Target->PendingClientOperations.Batch.Operations;
+		return Queued.Num() == 1 && Queued[0].GetPayloadIds() == TArray<int32> { EffectId }
+			&& Pending.Num() == 1 && Pending[0].OperationId == Queued[0].GetOperationId();
+	};
+
+	UGMC_AbilitySystemComponent* Source = MakeComponent();
+	double PerTargetSeconds = 0.0;
+	double BatchedSeconds = 0.0;
+
+	for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+	{
+		TArray<UGMC_AbilitySystemComponent*> PerTargetTargets;
+		TArray<UGMC_AbilitySystemComponent*> BatchedTargets;
+		for (int32 Idx = 0; Idx < NumTargets; Idx++)
+		{
+			PerTargetTargets.Add(MakeComponent());
+			BatchedTargets.Add(MakeComponent());
+		}
+
+		TArray<int32> PerTargetIds;
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			for (UGMC_AbilitySystemComponent* Target : PerTargetTargets)
+			{
+				int EffectHandle;
+				int EffectId;
+				UGMCAbilityEffect* Effect;
+				Target->ApplyAbilityEffect(EffectClass, EffectData, EGMCAbilityEffectQueueType::ServerAuth, EffectHandle, EffectId, Effect);
+				PerTargetIds.Add(EffectId);
+			}
+			PerTargetSeconds += FPlatformTime::Seconds() - StartTime;
+		}
+
+		TArray<int32> BatchedIds;
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			const int32 NumApplied = Source->ApplyAbilityEffectToTargets(EffectClass, EffectData, BatchedTargets, EGMCAbilityEffectQueueType::ServerAuth, BatchedIds);
+			BatchedSeconds += FPlatformTime::Seconds() - StartTime;
+
+			if (!TestEqual(TEXT("The effect is applied to every target"), NumApplied, NumTargets)
+				|| !TestEqual(TEXT("Every target gets an effect ID"), BatchedIds.Num(), NumTargets))
+			{
+				World->DestroyWorld(false);
+				return false;
+			}
+		}
+
+		for (int32 Idx = 0; Idx < NumTargets; Idx++)
+		{
+			if (!TestTrue(TEXT("Looping ApplyAbilityEffect queues one operation per target"), HasSingleOperation(PerTargetTargets[Idx], PerTargetIds[Idx]))
+				|| !TestTrue(TEXT("ApplyAbilityEffectToTargets queues one operation per target"), HasSingleOperation(BatchedTargets[Idx], BatchedIds[Idx]))
+				|| !TestTrue(TEXT("The batched operation carries the effect class"),
+					BatchedTargets[Idx]->QueuedEffectOperations.GetQueuedRPCOperations()[0].Header.ItemClassName == PerTargetTargets[Idx]->QueuedEffectOperations.GetQueuedRPCOperations()[0].Header.ItemClassName))
+			{
+				World->DestroyWorld(false);
+				return false;
+			}
+		}
+	}
+
+	// A target listed more than once gets one operation per listing, each with its own effect and operation IDs,
+	// whether the operations wait for a move or an RPC.
+	for (const EGMCAbilityEffectQueueType QueueType : { EGMCAbilityEffectQueueType::ServerAuth, EGMCAbilityEffectQueueType::ServerAuthMove })
+	{
+		UGMC_AbilitySystemComponent* Target = MakeComponent();
+		TArray<int32> EffectIds;
+		Source->ApplyAbilityEffectToTargets(EffectClass, EffectData, { Target, Target, nullptr }, QueueType, EffectIds);
+
+		const bool bMovementSynced = QueueType == EGMCAbilityEffectQueueType::ServerAuthMove;
+		TArray<int32> OperationIds;
+		if (bMovementSynced)
+		{
+			Target->QueuedEffectOperations.ForEachQueuedOperation(EGMASBoundQueueOperationType::Add, [&OperationIds](const FEffectOperation& Operation) { OperationIds.Add(Operation.GetOperationId()); });
+		}
+		else
+		{
+			Target->QueuedEffectOperations.GetQueuedRPCOperationIds(OperationIds);
+		}
+
+		const FString QueueName = UEnum::GetValueAsString(QueueType);
+		TestTrue(FString::Printf(TEXT("%s: a null target is skipped"), *QueueName), EffectIds.Num() == 3 && EffectIds[2] == -1);
+		TestTrue(FString::Printf(TEXT("%s: each listing gets its own effect ID"), *QueueName), EffectIds.Num() == 3 && EffectIds[0] != -1 && EffectIds[1] != -1 && EffectIds[0] != EffectIds[1]);
+		TestTrue(FString::Printf(TEXT("%s: each listing gets its own operation"), *QueueName), OperationIds.Num() == 2 && OperationIds[0] != OperationIds[1]);
+		TestEqual(FString::Printf(TEXT("%s: only server-auth operations are sent to the client"), *QueueName), Target->PendingClientOperations.Batch.Operations.Num(), bMovementSynced ? 0 : 2);
+	}
+
+	World->DestroyWorld(false);
+
+	AddInfo(FString::Printf(TEXT("%d targets: per-target %.3f ms, batched %.3f ms (average over %d runs)"),
+		NumTargets, PerTargetSeconds * 1000.0 / NumIterations, BatchedSeconds * 1000.0 / NumIterations, NumIterations));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,66 @@
+#include "Effects/GMCAbilityEffect.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Checks that effect payloads survive the delta-against-class-default net serialization, and reports how many bytes
+// it saves per queued operation compared to serializing every property of the payload.
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEffectDataNetSerializeTest, "UE5.Marketplace.DeepWorlds_GMCAbilitySystem.Source.GMCAbilitySystem.Public.Effects.EffectDataNetSerialize", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FEffectDataNetSerializeTest::RunTest(const FString& Parameters)
+{
+	// An instance-only payload, as sent when applying an effect with its class defaults.
+	FGMCAbilityEffectData InstancePayload;
+	InstancePayload.EffectID = 123456;
+	InstancePayload.StartTime = 42.5;
+	InstancePayload.bServerAuth = true;
+	InstancePayload.DefinitionClass = UGMCAbilityEffect::StaticClass();
+
+	// A payload overriding part of its class definition.
+	FGMCAbilityEffectData OverridePayload = InstancePayload;
+	OverridePayload.EffectType = EGMASEffectType::Ticking;
+	OverridePayload.Duration = 5.0;
+	OverridePayload.bPeriodicFirstTick = false;
+	OverridePayload.Modifiers.SetNum(2);
+	OverridePayload.Modifiers[0].ModifierValue = -10.f;
+	OverridePayload.Modifiers[1].Op = EModifierType::AddPercentageInitialValue;
+	OverridePayload.Modifiers[1].ModifierValue = 0.25f;
+
+	for (FGMCAbilityEffectData* Payload : { &InstancePayload, &OverridePayload })
+	{
+		FBitWriter LegacyWriter(0, true);
+		FGMCAbilityEffectData::StaticStruct()->SerializeBin(LegacyWriter, Payload);
+
+		FBitWriter Writer(0, true);
+		bool bSuccess = false;
+		Payload->NetSerialize(Writer, nullptr, bSuccess);
+		if (!TestTrue(TEXT("Payload serialized"), bSuccess && !Writer.IsError())) return false;
+
+		FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+		FGMCAbilityEffectData Loaded;
+		Loaded.NetSerialize(Reader, nullptr, bSuccess);
+		if (!TestTrue(TEXT("Payload deserialized"), bSuccess && !Reader.IsError())) return false;
+
+		TestEqual(TEXT("EffectID round trips"), Loaded.EffectID, Payload->EffectID);
+		TestEqual(TEXT("StartTime round trips"), Loaded.StartTime, Payload->StartTime);
+		TestTrue(TEXT("bServerAuth round trips"), Loaded.bServerAuth == Payload->bServerAuth);
+		TestTrue(TEXT("EffectType round trips"), Loaded.EffectType == Payload->EffectType);
+		TestEqual(TEXT("Duration round trips"), Loaded.Duration, Payload->Duration);
+		TestEqual(TEXT("bPeriodicFirstTick round trips"), Loaded.bPeriodicFirstTick, Payload->bPeriodicFirstTick);
+		TestTrue(TEXT("Modifiers round trip"), Loaded.Modifiers == Payload->Modifiers);
+		TestEqual(TEXT("Payload validity round trips"), Loaded.IsValid(), Payload->IsValid());
+
+		const int64 LegacyBytes = (LegacyWriter.GetNumBits() + 7) / 8;
+		const int64 DeltaBytes = (Writer.GetNumBits() + 7) / 8;
+		TestTrue(TEXT("Delta serialization is smaller than full serialization"), DeltaBytes < LegacyBytes);
+
+		AddInfo(FString::Printf(TEXT("%s payload: full %lld bytes, delta %lld bytes, %lld bytes saved per RPC"),
+			Payload->IsValid() ? TEXT("Override") : TEXT("Instance-only"), LegacyBytes, DeltaBytes, LegacyBytes - DeltaBytes));
+	}
+
+	return true;
+}
+
+#endif
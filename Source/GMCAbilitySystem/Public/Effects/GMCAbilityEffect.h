@@ -7,9 +7,18 @@
 #include "UObject/Object.h"
 #include "GMCAbilitySystem.h"
 #include "GMCAttributeModifier.h"
+
+// Fix for instanced struct on previous 5.5 version
+#if ENGINE_MAJOR_VERSION >=5 && ENGINE_MINOR_VERSION >= 5
+	#include "StructUtils/InstancedStruct.h"
+#else
+	#include "InstancedStruct.h"
+#endif
+
 #include "GMCAbilityEffect.generated.h"
 
 class UGMC_AbilitySystemComponent;
+class UGMCAbilityEffect;
 
 UENUM(BlueprintType)
 enum class EGMASEffectType : uint8
@@ -29,6 +38,60 @@ enum class EGMASEffectState : uint8
 };
 
 
+UENUM(BlueprintType)
+enum class EGMCEffectConditionType : uint8
+{
+	Attribute UMETA(DisplayName = "Attribute", ToolTip = "Compare the value of an owner attribute against a constant"),
+	HasAnyTags UMETA(DisplayName = "Has Any Tags", ToolTip = "The owner has at least one of the tags"),
+	HasAllTags UMETA(DisplayName = "Has All Tags", ToolTip = "The owner has every one of the tags"),
+	HasNoTags UMETA(DisplayName = "Has No Tags", ToolTip = "The owner has none of the tags"),
+};
+
+UENUM(BlueprintType)
+enum class EGMCConditionComparison : uint8
+{
+	Greater UMETA(DisplayName = ">"),
+	GreaterOrEqual UMETA(DisplayName = ">="),
+	Less UMETA(DisplayName = "<"),
+	LessOrEqual UMETA(DisplayName = "<="),
+	Equal UMETA(DisplayName = "=="),
+	NotEqual UMETA(DisplayName = "!="),
+};
+
+UENUM(BlueprintType)
+enum class EGMCEffectConditionCombine : uint8
+{
+	All UMETA(DisplayName = "All", ToolTip = "Every condition must pass"),
+	Any UMETA(DisplayName = "Any", ToolTip = "At least one condition must pass"),
+};
+
+// A natively evaluated condition gating the application of a ticking or periodic effect's modifiers.
+USTRUCT(BlueprintType)
+struct FGMCEffectDynamicCondition
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GMCAbilitySystem")
+	EGMCEffectConditionType Type { EGMCEffectConditionType::Attribute };
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GMCAbilitySystem", meta = (Categories="Attribute", EditCondition = "Type == EGMCEffectConditionType::Attribute", EditConditionHides))
+	FGameplayTag AttributeTag;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GMCAbilitySystem", meta = (EditCondition = "Type == EGMCEffectConditionType::Attribute", EditConditionHides))
+	EGMCConditionComparison Comparison { EGMCConditionComparison::Greater };
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GMCAbilitySystem", meta = (EditCondition = "Type == EGMCEffectConditionType::Attribute", EditConditionHides))
+	float Value { 0.f };
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GMCAbilitySystem", meta = (EditCondition = "Type != EGMCEffectConditionType::Attribute", EditConditionHides))
+	FGameplayTagContainer Tags;
+
+	// Where AttributeTag was last found in the owner's attributes, so evaluation doesn't search for it every tick.
+	int32 CachedAttributeSlot { INDEX_NONE };
+
+	// A missing attribute is only warned about once per effect, not every tick.
+	bool bWarnedMissingAttribute { false };
+};
 
 // Container for exposing the attribute modifier to blueprints
 UCLASS()
@@ -184,6 +247,71 @@ struct FGMCAbilityEffectData
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GMCAbilitySystem", meta = (DisplayName = "End Ability On End Via Definition Query"))
 	// end ability on effect end if definition matches query
 	FGameplayTagQuery EndAbilityOnEndQuery;
+
+	// The effect class this payload was built for. When set, NetSerialize only sends the fields which differ from
+	// that class's default EffectData.
+	UPROPERTY()
+	TSubclassOf<UGMCAbilityEffect> DefinitionClass { nullptr };
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FGMCAbilityEffectData> : public TStructOpsTypeTraitsBase2<FGMCAbilityEffectData>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
+
+// The per-instance state of an applied effect, i.e. everything which is not part of its class definition, plus the
+// definition itself if the effect was applied with data overriding its class defaults.
+// Used to replicate active effects and to apply effects using their class defaults without copying the full
+// FGMCAbilityEffectData around.
+USTRUCT(BlueprintType)
+struct FGMCAbilityEffectInstanceData
+{
+	GENERATED_BODY()
+
+	FGMCAbilityEffectInstanceData() {}
+
+	FGMCAbilityEffectInstanceData(const TSubclassOf<UGMCAbilityEffect>& InEffectClass, const FGMCAbilityEffectData& EffectData) :
+		EffectClass(InEffectClass),
+		SourceAbilityComponent(EffectData.SourceAbilityComponent),
+		EffectID(EffectData.EffectID),
+		bServerAuth(EffectData.bServerAuth),
+		StartTime(EffectData.StartTime),
+		EndTime(EffectData.EndTime)
+	{
+	}
+
+	UPROPERTY()
+	TSubclassOf<UGMCAbilityEffect> EffectClass { nullptr };
+
+	UPROPERTY(BlueprintReadOnly, Category = "GMCAbilitySystem")
+	UGMC_AbilitySystemComponent* SourceAbilityComponent { nullptr };
+
+	UPROPERTY(BlueprintReadOnly, Category = "GMCAbilitySystem")
+	int EffectID { 0 };
+
+	UPROPERTY()
+	bool bServerAuth { false };
+
+	UPROPERTY(BlueprintReadOnly, Category = "GMCAbilitySystem")
+	double StartTime { 0 };
+
+	UPROPERTY(BlueprintReadOnly, Category = "GMCAbilitySystem")
+	double EndTime { 0 };
+
+	// An FGMCAbilityEffectData with DefinitionClass set, only if the effect overrides its class definition; it
+	// replicates as a delta against the class defaults.
+	UPROPERTY()
+	FInstancedStruct DefinitionOverrides;
+
+	FString ToString() const{
+		return FString::Printf(TEXT("[id: %d] [Class: %s] (Start: %.3lf) (End: %.3lf)"), EffectID, *GetNameSafe(EffectClass), StartTime, EndTime);
+	}
 };
 
 /**
@@ -204,11 +332,12 @@ class GMCABILITYSYSTEM_API UGMCAbilityEffect : public UObject
 public:
 	EGMASEffectState CurrentState;
 
-	UPROPERTY(EditAnywhere, Category = "GMCAbilitySystem")
-	FGMCAbilityEffectData EffectData;
-
 	UFUNCTION(BlueprintCallable, Category = "GMCAbilitySystem")
-	void InitializeEffect(FGMCAbilityEffectData InitializationData);
+	void InitializeEffect(const FGMCAbilityEffectData& InitializationData);
+
+	// Initialize using the class definition, only applying the per-instance state (and the definition overrides,
+	// if the instance data carries any).
+	void InitializeEffectInstance(UGMC_AbilitySystemComponent* InOwnerAbilityComponent, const FGMCAbilityEffectInstanceData& InstanceData);
 
 	UFUNCTION(BlueprintCallable, Category = "GMCAbilitySystem")
 	void EndEffect();
@@ -223,17 +352,33 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category="GMAS|Effects")
 	float GetCurrentDuration() const { return EffectData.CurrentDuration; }
 
-	// Return the effect data struct of targeted effect
+	int32 GetEffectID() const { return EffectData.EffectID; }
+
+	bool IsServerAuth() const { return EffectData.bServerAuth; }
+
+	// Return the effect data struct of targeted effect, i.e. its definition combined with its instance state
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category="GMAS|Effects")
-	FGMCAbilityEffectData GetEffectData() const { return EffectData; }
+	FGMCAbilityEffectData GetEffectData() const;
+
+	// The definition this effect runs with: its class defaults, unless it was applied with overriding data.
+	const FGMCAbilityEffectData& GetDefinition() const
+	{
+		if (DefinitionOverrides) return *DefinitionOverrides;
+		return bInstanceStateOnly ? GetClass()->GetDefaultObject<UGMCAbilityEffect>()->EffectData : EffectData;
+	}
+
+	bool HasDefinitionOverrides() const { return DefinitionOverrides.IsValid(); }
+
+	// The compact per-instance state of this effect, as replicated to the owning client.
+	FGMCAbilityEffectInstanceData GetInstanceData() const;
 
 	// Return the total duration of the effect
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category="GMAS|Effects")
-	float GetEffectTotalDuration() const { return EffectData.Duration; }
+	float GetEffectTotalDuration() const { return GetDefinition().Duration; }
 
 	// Return the current remaining duration of the effect
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category="GMAS|Effects")
-	float GetEffectRemainingDuration() const { return EffectData.Duration - EffectData.CurrentDuration; }
+	float GetEffectRemainingDuration() const { return GetDefinition().Duration - EffectData.CurrentDuration; }
 
 	UFUNCTION(BlueprintNativeEvent, meta=(DisplayName="Effect Tick"), Category="GMCAbilitySystem")
 	void TickEvent(float DeltaTime);
@@ -242,6 +387,17 @@ public:
 	// However, this is not stopping the effect.
 	UFUNCTION(BlueprintNativeEvent, meta=(DisplayName="Dynamic Condition"), Category="GMCAbilitySystem")
 	bool AttributeDynamicCondition() const;
+
+	// Conditions evaluated natively before the Dynamic Condition event, which is only called if overridden in Blueprint
+	// (or natively). Like the event, they only gate the modifiers, they don't end the effect.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "GMCAbilitySystem|Conditions")
+	TArray<FGMCEffectDynamicCondition> DynamicConditions;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "GMCAbilitySystem|Conditions")
+	EGMCEffectConditionCombine DynamicConditionCombine { EGMCEffectConditionCombine::All };
+
+	// Evaluates DynamicConditions, then the Dynamic Condition event.
+	bool CheckDynamicConditions();
 	
 	void PeriodTick();
 
@@ -270,6 +426,11 @@ public:
 
 protected:
 
+	// The definition on the class defaults. On an initialized effect, only its instance state (IDs, components and
+	// times); read the definition through GetDefinition, or both combined through GetEffectData.
+	UPROPERTY(EditAnywhere, Category = "GMCAbilitySystem")
+	FGMCAbilityEffectData EffectData;
+
 	UPROPERTY(Transient)
 	TMap<TSubclassOf<UGMCAttributeModifierCustom_Base>, UGMCAttributeModifierCustom_Base*> CustomModifiersInstances;
 
@@ -279,9 +440,32 @@ protected:
 	// Apply the things that should happen as soon as an effect starts. Tags, instant effects, etc.
 	virtual void StartEffect();
 
+	// Shared tail of InitializeEffect/InitializeEffectInstance, once EffectData holds the instance state.
+	void BeginEffectInstance();
+
+	// The definition, copied out of the class defaults first if this effect doesn't have its own yet.
+	FGMCAbilityEffectData& GetMutableDefinition();
+
 private:
+	// Assigns effect IDs as it adds effects.
+	friend class UGMC_AbilitySystemComponent;
+
+	// Set once initialized; until then (and always on the class defaults) EffectData still holds the full definition.
+	bool bInstanceStateOnly { false };
+
+	// Only allocated for effects applied with data overriding their class definition, or modified at runtime.
+	TUniquePtr<FGMCAbilityEffectData> DefinitionOverrides;
+
+	// Keep the instance state of Data in EffectData and drop the rest, which now lives in the definition.
+	void SetInstanceState(const FGMCAbilityEffectData& Data);
+
 	bool bHasStarted;
 	bool bHasAppliedEffect;
+
+	// Whether the Dynamic Condition event is implemented in Blueprint, and so has to go through the script VM.
+	bool bScriptDynamicCondition { false };
+
+	bool EvaluateDynamicCondition(FGMCEffectDynamicCondition& Condition) const;
 	
 	void CheckState();
 
@@ -296,7 +480,7 @@ private:
 	void EndActiveAbilitiesFromOwner(const FGameplayTagContainer& TagContainer);
 
 	// Does the owner have any of the tags from the container?
-	bool DoesOwnerHaveTagFromContainer(FGameplayTagContainer& TagContainer) const;
+	bool DoesOwnerHaveTagFromContainer(const FGameplayTagContainer& TagContainer) const;
 	
 	bool DuplicateEffectAlreadyApplied();
 
@@ -314,7 +498,7 @@ public:
 
 	
 	FString ToString() {
-		return FString::Printf(TEXT("[name: %s] (%s) | %s | %s | Data: %s"), *GetName().Right(30), *EnumToString(CurrentState), bHasStarted ? TEXT("Started") : TEXT("Not Started"), IsPaused() ? TEXT("Paused") : TEXT("Running"), *EffectData.ToString());
+		return FString::Printf(TEXT("[name: %s] (%s) | %s | %s | Data: %s"), *GetName().Right(30), *EnumToString(CurrentState), bHasStarted ? TEXT("Started") : TEXT("Not Started"), IsPaused() ? TEXT("Paused") : TEXT("Running"), *GetEffectData().ToString());
 	}
 
 	UFUNCTION(BlueprintCallable, Category = "GMCAbilitySystem|Effects|Queries")
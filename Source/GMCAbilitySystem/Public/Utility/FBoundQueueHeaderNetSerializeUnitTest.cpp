@@ -0,0 +1,107 @@
+#include "Misc/AutomationTest.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+#include "UObject/CoreNet.h"
+#include "Utility/GMASBoundQueue.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	// The header as default property replication sends it: every field, at full width.
+	void SerializeHeaderAsProperties(FArchive& Ar, FGMASBoundQueueRPCHeader& Header)
+	{
+		bool bSuccess = true;
+		Ar << Header.OperationId;
+		Ar << Header.OperationTypeRaw;
+		Header.Tag.NetSerialize(Ar, nullptr, bSuccess);
+		Ar << Header.ItemClassNetId;
+		UPackageMap::StaticSerializeName(Ar, Header.ItemClassName);
+		uint16 NumIds = Header.PayloadIds.Ids.Num();
+		Ar << NumIds;
+		for (int32& Id : Header.PayloadIds.Ids)
+		{
+			Ar << Id;
+		}
+		Header.InstancedPayload.NetSerialize(Ar, nullptr, bSuccess);
+		Ar << Header.RPCGracePeriodSeconds;
+		Ar << Header.ExtraFlags;
+	}
+}
+
+// Measures the average size of the effect operation headers we send to clients, with default property replication
+// and with the packed NetSerialize, and checks the packed headers round-trip.
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBoundQueueHeaderNetSerializeTest, "UE5.Marketplace.DeepWorlds_GMCAbilitySystem.Source.GMCAbilitySystem.Public.Utility.BoundQueueHeaderNetSerialize", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FBoundQueueHeaderNetSerializeTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumHeaders = 100;
+
+	// A burst of effect additions and removals, as queued over a couple of seconds of play.
+	FGMASBoundQueueOperationBatch Batch;
+	for (int32 Idx = 0; Idx < NumHeaders; Idx++)
+	{
+		FGMASBoundQueueRPCHeader& Header = Batch.Operations.AddDefaulted_GetRef();
+		Header.OperationId = FGMASIdAllocator::GetSeed(3600.0 + Idx * 0.02);
+		Header.OperationTypeRaw = static_cast<uint8>(Idx % 4 == 0 ? EGMASBoundQueueOperationType::Remove : EGMASBoundQueueOperationType::Add);
+		Header.ItemClassNetId = static_cast<uint16>(1 + Idx % 12);
+		Header.PayloadIds.Ids = { Header.OperationId + 3 };
+		Header.RPCGracePeriodSeconds = Idx % 3 == 0 ? 0.5f : 1.f;
+		Header.ExtraFlags = Idx % 2;
+	}
+
+	int64 PropertyBits = 0;
+	int64 PackedBits = 0;
+	for (FGMASBoundQueueRPCHeader& Header : Batch.Operations)
+	{
+		FBitWriter PropertyWriter(0, true);
+		SerializeHeaderAsProperties(PropertyWriter, Header);
+		PropertyBits += PropertyWriter.GetNumBits();
+
+		FBitWriter PackedWriter(0, true);
+		bool bSuccess = false;
+		Header.NetSerialize(PackedWriter, nullptr, bSuccess);
+		if (!TestTrue(TEXT("Header serialized"), bSuccess && !PackedWriter.IsError())) return false;
+		PackedBits += PackedWriter.GetNumBits();
+
+		FBitReader Reader(PackedWriter.GetData(), PackedWriter.GetNumBits());
+		FGMASBoundQueueRPCHeader Loaded;
+		Loaded.NetSerialize(Reader, nullptr, bSuccess);
+		if (!TestTrue(TEXT("Header deserialized"), bSuccess && !Reader.IsError())) return false;
+
+		TestEqual(TEXT("OperationId round trips"), Loaded.OperationId, Header.OperationId);
+		TestEqual(TEXT("Operation type round trips"), Loaded.OperationTypeRaw, Header.OperationTypeRaw);
+		TestEqual(TEXT("Class net ID round trips"), Loaded.ItemClassNetId, Header.ItemClassNetId);
+		TestTrue(TEXT("Payload IDs round trip"), Loaded.PayloadIds.Ids == Header.PayloadIds.Ids);
+		TestEqual(TEXT("Grace period round trips"), Loaded.RPCGracePeriodSeconds, Header.RPCGracePeriodSeconds);
+		TestEqual(TEXT("Extra flags round trip"), Loaded.ExtraFlags, Header.ExtraFlags);
+	}
+
+	// Sent together, each operation ID is relative to the previous one.
+	FBitWriter BatchWriter(0, true);
+	bool bSuccess = false;
+	Batch.NetSerialize(BatchWriter, nullptr, bSuccess);
+	if (!TestTrue(TEXT("Batch serialized"), bSuccess && !BatchWriter.IsError())) return false;
+
+	FBitReader BatchReader(BatchWriter.GetData(), BatchWriter.GetNumBits());
+	FGMASBoundQueueOperationBatch LoadedBatch;
+	LoadedBatch.NetSerialize(BatchReader, nullptr, bSuccess);
+	if (!TestTrue(TEXT("Batch deserialized"), bSuccess && !BatchReader.IsError())) return false;
+	if (!TestEqual(TEXT("Batch size round trips"), LoadedBatch.Operations.Num(), NumHeaders)) return false;
+	for (int32 Idx = 0; Idx < NumHeaders; Idx++)
+	{
+		TestEqual(TEXT("Batched OperationId round trips"), LoadedBatch.Operations[Idx].OperationId, Batch.Operations[Idx].OperationId);
+	}
+
+	const double PropertyBytes = PropertyBits / 8.0 / NumHeaders;
+	const double PackedBytes = PackedBits / 8.0 / NumHeaders;
+	const double BatchedBytes = BatchWriter.GetNumBits() / 8.0 / NumHeaders;
+	TestTrue(TEXT("Packed headers are smaller than property headers"), PackedBytes < PropertyBytes);
+
+	AddInfo(FString::Printf(TEXT("Average header size over %d operations: properties %.2f bytes, packed %.2f bytes, packed in a batch %.2f bytes"),
+		NumHeaders, PropertyBytes, PackedBytes, BatchedBytes));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,480 @@
+#include "Effects/GMCAbilityEffect.h"
+#include "Misc/AutomationTest.h"
+#include "Utility/GMASBoundQueue.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	using FServerAuthQueue = TGMASBoundQueue<UGMCAbilityEffect, FGMCAbilityEffectData, false>;
+	using FClientAuthQueue = TGMASBoundQueue<UGMCAbilityEffect, FGMCAbilityEffectData, true>;
+	using FEffectOperation = TGMASBoundQueueOperation<UGMCAbilityEffect, FGMCAbilityEffectData>;
+
+	// Stands in for UGMC_MovementUtilityCmp's bindings: records what a queue binds, and can copy bound values from
+	// one "side" to the other the way GMC would when a move arrives.
+	struct FMockMovementComponent
+	{
+		struct FBinding
+		{
+			double* Double { nullptr };
+			FInstancedStruct* Struct { nullptr };
+			EGMC_PredictionMode Prediction;
+		};
+		TArray<FBinding> Bindings;
+
+		int BindDoublePrecisionFloat(double& Value, EGMC_PredictionMode Prediction, EGMC_CombineMode, EGMC_SimulationMode, EGMC_InterpolationFunction)
+		{
+			return Bindings.Add({ &Value, nullptr, Prediction });
+		}
+
+		int BindInstancedStruct(FInstancedStruct& Value, EGMC_PredictionMode Prediction, EGMC_CombineMode, EGMC_SimulationMode, EGMC_InterpolationFunction)
+		{
+			return Bindings.Add({ nullptr, &Value, Prediction });
+		}
+
+		int32 NumBindings(EGMC_PredictionMode Prediction) const
+		{
+			return Bindings.FilterByPredicate([Prediction](const FBinding& Binding) { return Binding.Prediction == Prediction; }).Num();
+		}
+
+		// Deliver our client-auth inputs to the server's copy of the same bindings.
+		void SendInputsTo(FMockMovementComponent& Server) const
+		{
+			for (int32 Idx = 0; Idx < Bindings.Num() && Idx < Server.Bindings.Num(); Idx++)
+			{
+				if (Bindings[Idx].Prediction != EGMC_PredictionMode::ClientAuth_Input) continue;
+
+				if (Bindings[Idx].Struct && Server.Bindings[Idx].Struct) *Server.Bindings[Idx].Struct = *Bindings[Idx].Struct;
+				if (Bindings[Idx].Double && Server.Bindings[Idx].Double) *Server.Bindings[Idx].Double = *Bindings[Idx].Double;
+			}
+		}
+	};
+
+	// Each operation targets its own effect unless given an effect ID.
+	int32 QueueTestOperation(FServerAuthQueue& Queue, EGMASBoundQueueOperationType Type, bool bMovementSynced, float GracePeriod = 1.f, int32 EffectId = 0)
+	{
+		FGMCAbilityEffectData Payload;
+		Payload.EffectID = EffectId != 0 ? EffectId : Queue.GenerateOperationId();
+
+		FEffectOperation Operation;
+		Queue.MakeOperation(Operation, Type, FGameplayTag::EmptyTag, Payload, { Payload.EffectID }, UGMCAbilityEffect::StaticClass(), GracePeriod);
+		Queue.QueuePreparedOperation(Operation, bMovementSynced);
+		return Operation.GetOperationId();
+	}
+
+	template<typename AllocatorType>
+	FString DescribeIds(const TArray<int32, AllocatorType>& Ids)
+	{
+		return FString::JoinBy(Ids, TEXT(", "), [](int32 Id) { return FString::FromInt(Id); });
+	}
+}
+
+// Drives bound queues against a mock movement component: binding, ID generation, lane draining, and the races
+// between client acknowledgements, grace period expiry and ack expiry.
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGMASBoundQueueTest, "UE5.Marketplace.DeepWorlds_GMCAbilitySystem.Source.GMCAbilitySystem.Public.Utility.BoundQueue", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGMASBoundQueueTest::RunTest(const FString& Parameters)
+{
+	// Binding
+	{
+		FServerAuthQueue ServerAuthQueue;
+		FMockMovementComponent ServerAuthMovement;
+		ServerAuthQueue.BindToGMC(&ServerAuthMovement);
+		TestEqual(TEXT("Server-auth queue binds its action timer and acknowledgements"), ServerAuthMovement.Bindings.Num(), 2);
+		TestEqual(TEXT("Server-auth queue acknowledgements are client input"), ServerAuthMovement.NumBindings(EGMC_PredictionMode::ClientAuth_Input), 1);
+
+		FClientAuthQueue ClientAuthQueue;
+		FMockMovementComponent ClientAuthMovement;
+		ClientAuthQueue.BindToGMC(&ClientAuthMovement);
+		TestEqual(TEXT("Client-auth queue binds its action timer and current operations"), ClientAuthMovement.Bindings.Num(), 2);
+		TestTrue(TEXT("Client-auth queue binds its current operations"), ClientAuthMovement.Bindings.ContainsByPredicate([&](const FMockMovementComponent::FBinding& Binding)
+		{
+			return Binding.Struct == &ClientAuthQueue.CurrentOperations;
+		}));
+	}
+
+	// ID generation: operations queued on the same tick still get distinct IDs.
+	{
+		FServerAuthQueue Queue;
+		FMockMovementComponent Movement;
+		Queue.BindToGMC(&Movement);
+
+		TSet<int32> Ids;
+		for (int32 Idx = 0; Idx < 1000; Idx++)
+		{
+			Ids.Add(QueueTestOperation(Queue, EGMASBoundQueueOperationType::Add, Idx % 2 == 0));
+		}
+		TestEqual(TEXT("Operation IDs are unique"), Ids.Num(), 1000);
+		TestFalse(TEXT("Operation IDs are valid"), Ids.Contains(FGMASIdAllocator::InvalidId));
+	}
+
+	// Lane draining: cancels and removals preempt adds queued before them, adds stay in order.
+	{
+		FServerAuthQueue Queue;
+		FMockMovementComponent Movement;
+		Queue.BindToGMC(&Movement);
+		Queue.MaxOperationsPerMove = 4;
+
+		TArray<int32> AddIds;
+		for (int32 Idx = 0; Idx < 5; Idx++)
+		{
+			Queue.ActionTimer += 0.1;
+			AddIds.Add(QueueTestOperation(Queue, EGMASBoundQueueOperationType::Add, true));
+		}
+		const int32 RemoveId = QueueTestOperation(Queue, EGMASBoundQueueOperationType::Remove, true);
+		const int32 CancelId = QueueTestOperation(Queue, EGMASBoundQueueOperationType::Cancel, true);
+		TestEqual(TEXT("Every operation is queued"), Queue.Num(), 7);
+
+		Queue.PreRemoteMovement();
+		TArray<int32> FirstMove;
+		FEffectOperation Operation;
+		for (int32 Idx = 0; Queue.GetCurrentBoundOperation(Idx, Operation); Idx++)
+		{
+			FirstMove.Add(Operation.GetOperationId());
+		}
+		const TArray<int32> ExpectedFirstMove { CancelId, RemoveId, AddIds[0], AddIds[1] };
+		TestTrue(FString::Printf(TEXT("First move is the cancel, the removal, then the oldest adds (got %s)"), *DescribeIds(FirstMove)), FirstMove == ExpectedFirstMove);
+		TestEqual(TEXT("Taken operations leave the queue"), Queue.Num(), 3);
+		TestFalse(TEXT("Taken operations are no longer found"), Queue.HasOperationWithId(CancelId));
+
+		Queue.PreRemoteMovement();
+		TArray<int32> SecondMove;
+		for (int32 Idx = 0; Queue.GetCurrentBoundOperation(Idx, Operation); Idx++)
+		{
+			SecondMove.Add(Operation.GetOperationId());
+		}
+		const TArray<int32> ExpectedSecondMove { AddIds[2], AddIds[3], AddIds[4] };
+		TestTrue(FString::Printf(TEXT("Second move is the remaining adds in order (got %s)"), *DescribeIds(SecondMove)), SecondMove == ExpectedSecondMove);
+
+		Queue.PreRemoteMovement();
+		TestEqual(TEXT("An idle move binds nothing"), Queue.NumCurrentBoundOperations(), 0);
+	}
+
+	// Lane draining: a removal never overtakes the addition of the same effect, but still overtakes unrelated ones.
+	{
+		FServerAuthQueue Queue;
+		FMockMovementComponent Movement;
+		Queue.BindToGMC(&Movement);
+		Queue.MaxOperationsPerMove = 4;
+
+		const int32 OtherAddId = QueueTestOperation(Queue, EGMASBoundQueueOperationType::Add, true);
+		constexpr int32 EffectId = 12345;
+		const int32 AddId = QueueTestOperation(Queue, EGMASBoundQueueOperationType::Add, true, 1.f, EffectId);
+		const int32 RemoveId = QueueTestOperation(Queue, EGMASBoundQueueOperationType::Remove, true, 1.f, EffectId);
+		const int32 LaterAddId = QueueTestOperation(Queue, EGMASBoundQueueOperationType::Add, true);
+
+		Queue.PreRemoteMovement();
+		TArray<int32> Move;
+		FEffectOperation Operation;
+		for (int32 Idx = 0; Queue.GetCurrentBoundOperation(Idx, Operation); Idx++)
+		{
+			Move.Add(Operation.GetOperationId());
+		}
+		const TArray<int32> ExpectedMove { OtherAddId, AddId, RemoveId, LaterAddId };
+		TestTrue(FString::Printf(TEXT("The removal waits for its addition, then goes before later adds (got %s)"), *DescribeIds(Move)), Move == ExpectedMove);
+
+		// With room for only one operation per move, the pair still lands in order.
+		Queue.MaxOperationsPerMove = 1;
+		const int32 SecondAddId = QueueTestOperation(Queue, EGMASBoundQueueOperationType::Add, true, 1.f, EffectId + 1);
+		const int32 SecondRemoveId = QueueTestOperation(Queue, EGMASBoundQueueOperationType::Remove, true, 1.f, EffectId + 1);
+
+		Queue.PreRemoteMovement();
+		TestTrue(TEXT("The addition goes first"), Queue.GetCurrentBoundOperation(0, Operation) && Operation.GetOperationId() == SecondAddId);
+		Queue.PreRemoteMovement();
+		TestTrue(TEXT("The removal follows on the next move"), Queue.GetCurrentBoundOperation(0, Operation) && Operation.GetOperationId() == SecondRemoveId);
+		TestEqual(TEXT("Both have left the queue"), Queue.Num(), 0);
+	}
+
+	// Lane draining over many moves: what's left in a lane stays in order and findable as taken slots are reclaimed.
+	{
+		FServerAuthQueue Queue;
+		FMockMovementComponent Movement;
+		Queue.BindToGMC(&Movement);
+		Queue.MaxOperationsPerMove = 3;
+
+		TArray<int32> AddIds;
+		for (int32 Idx = 0; Idx < 20; Idx++)
+		{
+			AddIds.Add(QueueTestOperation(Queue, EGMASBoundQueueOperationType::Add, true));
+		}
+
+		int32 NumTaken = 0;
+		bool bInOrder = true;
+		bool bRestFindable = true;
+		FEffectOperation Operation;
+		while (Queue.Num() > 0)
+		{
+			Queue.PreRemoteMovement();
+			for (int32 Idx = 0; Queue.GetCurrentBoundOperation(Idx, Operation); Idx++)
+			{
+				bInOrder &= AddIds.IsValidIndex(NumTaken) && Operation.GetOperationId() == AddIds[NumTaken];
+				NumTaken++;
+			}
+
+			for (int32 Idx = NumTaken; Idx < AddIds.Num(); Idx++)
+			{
+				const FEffectOperation* Queued = Queue.FindOperationById(AddIds[Idx]);
+				bRestFindable &= Queued && Queued->GetOperationId() == AddIds[Idx];
+			}
+			int32 NumQueuedAdds = 0;
+			Queue.ForEachQueuedOperation(EGMASBoundQueueOperationType::Add, [&NumQueuedAdds](const FEffectOperation&) { NumQueuedAdds++; });
+			bRestFindable &= NumQueuedAdds == AddIds.Num() - NumTaken;
+		}
+		TestEqual(TEXT("Every add is taken"), NumTaken, AddIds.Num());
+		TestTrue(TEXT("Adds are taken in the order they were queued"), bInOrder);
+		TestTrue(TEXT("Adds not yet taken stay findable"), bRestFindable);
+	}
+
+	// Removing from bound lanes: removed operations are skipped, including at the head of a lane and once the lane
+	// has been compacted, and what's left keeps its order.
+	{
+		FServerAuthQueue Queue;
+		FMockMovementComponent Movement;
+		Queue.BindToGMC(&Movement);
+		Queue.MaxOperationsPerMove = 4;
+
+		TArray<int32> AddIds;
+		for (int32 Idx = 0; Idx < 12; Idx++)
+		{
+			AddIds.Add(QueueTestOperation(Queue, EGMASBoundQueueOperationType::Add, true));
+		}
+
+		// The head of the lane, then every third add.
+		TArray<int32> ExpectedIds;
+		for (int32 Idx = 0; Idx < AddIds.Num(); Idx++)
+		{
+			if (Idx % 3 == 0)
+			{
+				TestTrue(TEXT("A queued add is removed"), Queue.RemoveOperationById(AddIds[Idx]));
+			}
+			else
+			{
+				ExpectedIds.Add(AddIds[Idx]);
+			}
+		}
+		TestFalse(TEXT("A removed add can't be removed again"), Queue.RemoveOperationById(AddIds[0]));
+		TestFalse(TEXT("A removed add is no longer found"), Queue.HasOperationWithId(AddIds[3]));
+		TestEqual(TEXT("Removed adds leave the queue"), Queue.Num(), ExpectedIds.Num());
+
+		// Taking the first move passes over two removed adds, which compacts the lane; then remove one more from it.
+		Queue.PreRemoteMovement();
+		TArray<int32> TakenIds;
+		FEffectOperation Operation;
+		for (int32 Idx = 0; Queue.GetCurrentBoundOperation(Idx, Operation); Idx++)
+		{
+			TakenIds.Add(Operation.GetOperationId());
+		}
+		TestTrue(TEXT("An add after the ones taken is removed"), Queue.RemoveOperationById(ExpectedIds[6]));
+		ExpectedIds.RemoveAt(6);
+
+		while (Queue.Num() > 0)
+		{
+			Queue.PreRemoteMovement();
+			for (int32 Idx = 0; Queue.GetCurrentBoundOperation(Idx, Operation); Idx++)
+			{
+				TakenIds.Add(Operation.GetOperationId());
+			}
+		}
+		TestTrue(FString::Printf(TEXT("Only the adds left are taken, in order (got %s)"), *DescribeIds(TakenIds)), TakenIds == ExpectedIds);
+	}
+
+	// Acknowledgements racing grace periods.
+	{
+		FServerAuthQueue ServerQueue;
+		FServerAuthQueue ClientQueue;
+		FMockMovementComponent ServerMovement;
+		FMockMovementComponent ClientMovement;
+		ServerQueue.BindToGMC(&ServerMovement);
+		ClientQueue.BindToGMC(&ClientMovement);
+
+		const int32 AckedId = QueueTestOperation(ServerQueue, EGMASBoundQueueOperationType::Add, false);
+		const int32 ExpiringId = QueueTestOperation(ServerQueue, EGMASBoundQueueOperationType::Add, false);
+		for (const int32 Id : { AckedId, ExpiringId })
+		{
+			ClientQueue.QueueOperationFromHeader(ServerQueue.FindOperationById(Id)->Header, false);
+		}
+
+		TArray<int32, TInlineAllocator<16>> DueIds;
+		ServerQueue.AdvanceGraceClock(0.1f);
+		ServerQueue.GetDueRPCOperationIds(DueIds);
+		TestEqual(TEXT("Nothing is due before an ack or the grace period"), DueIds.Num(), 0);
+
+		// The client acks one operation; it's due on the server as soon as the ack arrives.
+		ClientQueue.Acknowledge(AckedId);
+		ClientMovement.SendInputsTo(ServerMovement);
+		TestTrue(TEXT("Ack arrives on the server"), ServerQueue.IsAcknowledged(AckedId));
+		ServerQueue.GetDueRPCOperationIds(DueIds);
+		TestTrue(FString::Printf(TEXT("Only the acked operation is due (got %s)"), *DescribeIds(DueIds)), DueIds.Num() == 1 && DueIds[0] == AckedId);
+		ServerQueue.RemoveOperationById(AckedId);
+
+		// The other runs out of grace; the processed one's deadline passes too, but it's gone and isn't reported.
+		ServerQueue.AdvanceGraceClock(1.f);
+		ServerQueue.GetDueRPCOperationIds(DueIds);
+		TestTrue(FString::Printf(TEXT("Only the expired operation is due (got %s)"), *DescribeIds(DueIds)), DueIds.Num() == 1 && DueIds[0] == ExpiringId);
+		TestTrue(TEXT("The expired operation reports as expired"), ServerQueue.IsGracePeriodExpired(*ServerQueue.FindOperationById(ExpiringId)));
+		ServerQueue.RemoveOperationById(ExpiringId);
+
+		// A late ack for an operation the server already forced through is ignored.
+		ClientQueue.Acknowledge(ExpiringId);
+		ClientMovement.SendInputsTo(ServerMovement);
+		ServerQueue.GetDueRPCOperationIds(DueIds);
+		TestEqual(TEXT("A late ack for a processed operation is not due"), DueIds.Num(), 0);
+
+		// Acked and expired on the same tick: reported once.
+		ServerQueue.ActionTimer += 1.0;
+		const int32 RacingId = QueueTestOperation(ServerQueue, EGMASBoundQueueOperationType::Add, false, 0.5f);
+		ServerQueue.AdvanceGraceClock(0.5f);
+		ClientQueue.Acknowledge(RacingId);
+		ClientMovement.SendInputsTo(ServerMovement);
+		ServerQueue.GetDueRPCOperationIds(DueIds);
+		TestTrue(FString::Printf(TEXT("An operation acked as it expires is due once (got %s)"), *DescribeIds(DueIds)), DueIds.Num() == 1 && DueIds[0] == RacingId);
+		ServerQueue.RemoveOperationById(RacingId);
+
+		// An ID reused after removal doesn't inherit the old operation's deadline.
+		ServerQueue.ActionTimer += 10.0;
+		const int32 ShortId = QueueTestOperation(ServerQueue, EGMASBoundQueueOperationType::Add, false, 0.5f);
+		ServerQueue.RemoveOperationById(ShortId);
+		const int32 LongId = QueueTestOperation(ServerQueue, EGMASBoundQueueOperationType::Add, false, 2.f);
+		TestEqual(TEXT("The removed operation's ID is reused"), LongId, ShortId);
+		ServerQueue.AdvanceGraceClock(1.f);
+		ServerQueue.GetDueRPCOperationIds(DueIds);
+		TestEqual(TEXT("A reused ID isn't due on the old deadline"), DueIds.Num(), 0);
+		ServerQueue.AdvanceGraceClock(1.f);
+		ServerQueue.GetDueRPCOperationIds(DueIds);
+		TestTrue(TEXT("A reused ID is due on its own deadline"), DueIds.Num() == 1 && DueIds[0] == LongId);
+	}
+
+	// Ack expiry: acks are forgotten once the action timer has moved past their lifetime.
+	{
+		FServerAuthQueue Queue;
+		FMockMovementComponent Movement;
+		Queue.BindToGMC(&Movement);
+		Queue.ActionTimer = 100.0;
+
+		const int32 OldId = QueueTestOperation(Queue, EGMASBoundQueueOperationType::Add, false);
+		Queue.Acknowledge(OldId);
+		Queue.GenPredictionTick(Queue.AckLifetimeSeconds - 1.f);
+		const int32 RecentId = QueueTestOperation(Queue, EGMASBoundQueueOperationType::Add, false);
+		Queue.Acknowledge(RecentId);
+		TestTrue(TEXT("An ack is remembered within its lifetime"), Queue.IsAcknowledged(OldId));
+
+		Queue.GenPredictionTick(2.f);
+		TestFalse(TEXT("An ack is forgotten after its lifetime"), Queue.IsAcknowledged(OldId));
+		TestTrue(TEXT("Newer acks survive older ones expiring"), Queue.IsAcknowledged(RecentId));
+	}
+
+	// Ack window overflow: a newer ack slides the window forward and reports the acks it pushes out.
+	{
+		FGMASBoundQueueAckWindow Acks;
+		constexpr int32 FarId = FGMASBoundQueueAckWindow::NumBits + 5;
+		bool bDroppedAcks = false;
+		Acks.Add(0);
+		Acks.Add(10);
+		TestTrue(TEXT("A far newer ack is recorded"), Acks.Add(FarId, bDroppedAcks) && Acks.Contains(FarId));
+		TestTrue(TEXT("Acks pushed out of the window are reported"), bDroppedAcks && !Acks.Contains(0));
+		TestTrue(TEXT("Acks still in the window are kept"), Acks.Contains(10));
+
+		Acks.Add(FarId + 1, bDroppedAcks);
+		TestFalse(TEXT("An ack which fits doesn't report drops"), bDroppedAcks);
+		TestFalse(TEXT("An ack older than the window allows isn't recorded"), Acks.Add(0));
+	}
+
+	// Ack expiry keeps the window in range: a minute of steady acks never pushes one out within its lifetime.
+	{
+		FServerAuthQueue Queue;
+		FMockMovementComponent Movement;
+		Queue.BindToGMC(&Movement);
+
+		constexpr float TickSeconds = 0.1f;
+		TArray<TPair<double, int32>> AckedIds;
+		for (int32 Tick = 0; Tick < 600; Tick++)
+		{
+			const int32 Id = QueueTestOperation(Queue, EGMASBoundQueueOperationType::Add, false, 60.f);
+			Queue.Acknowledge(Id);
+			AckedIds.Emplace(Queue.ActionTimer, Id);
+			Queue.GenPredictionTick(TickSeconds);
+		}
+
+		int32 NumLost = 0;
+		for (const TPair<double, int32>& Acked : AckedIds)
+		{
+			const bool bWithinLifetime = Queue.ActionTimer - Acked.Key < Queue.AckLifetimeSeconds - TickSeconds;
+			NumLost += bWithinLifetime && !Queue.IsAcknowledged(Acked.Value) ? 1 : 0;
+		}
+		TestEqual(TEXT("No ack within its lifetime is lost"), NumLost, 0);
+		TestFalse(TEXT("Acks past their lifetime are forgotten"), Queue.IsAcknowledged(AckedIds[0].Value));
+	}
+
+	return true;
+}
+
+// Enqueue, lookup and ack throughput of a bound queue with 10, 100 and 1000 pending operations.
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGMASBoundQueueBenchmark, "UE5.Marketplace.DeepWorlds_GMCAbilitySystem.Source.GMCAbilitySystem.Public.Utility.BoundQueueBenchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGMASBoundQueueBenchmark::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumIterations = 20;
+
+	// 1000 operations acked at once spread wider than the ack window.
+	AddExpectedError(TEXT("Bound queue acks span more than"), EAutomationExpectedErrorFlags::Contains, 0);
+
+	for (const int32 NumOperations : { 10, 100, 1000 })
+	{
+		double EnqueueSeconds = 0.0;
+		double LookupSeconds = 0.0;
+		double AckSeconds = 0.0;
+		int32 NumFound = 0;
+		int32 NumDue = 0;
+
+		for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+		{
+			FServerAuthQueue Queue;
+			FMockMovementComponent Movement;
+			Queue.BindToGMC(&Movement);
+
+			TArray<int32> Ids;
+			Ids.Reserve(NumOperations);
+
+			double StartTime = FPlatformTime::Seconds();
+			for (int32 Idx = 0; Idx < NumOperations; Idx++)
+			{
+				Ids.Add(QueueTestOperation(Queue, EGMASBoundQueueOperationType::Add, false));
+			}
+			EnqueueSeconds += FPlatformTime::Seconds() - StartTime;
+
+			StartTime = FPlatformTime::Seconds();
+			for (const int32 Id : Ids)
+			{
+				NumFound += Queue.FindOperationById(Id) ? 1 : 0;
+			}
+			LookupSeconds += FPlatformTime::Seconds() - StartTime;
+
+			TArray<int32, TInlineAllocator<16>> DueIds;
+			StartTime = FPlatformTime::Seconds();
+			for (const int32 Id : Ids)
+			{
+				Queue.Acknowledge(Id);
+			}
+			Queue.GetDueRPCOperationIds(DueIds);
+			AckSeconds += FPlatformTime::Seconds() - StartTime;
+
+			// A burst wider than the ack window leaves some operations to their grace period instead.
+			TSet<int32> DueIdSet(DueIds);
+			Queue.AdvanceGraceClock(2.f);
+			Queue.GetDueRPCOperationIds(DueIds);
+			DueIdSet.Append(DueIds);
+			NumDue += DueIdSet.Num();
+		}
+
+		TestEqual(FString::Printf(TEXT("Every operation is found with %d pending"), NumOperations), NumFound, NumOperations * NumIterations);
+		TestEqual(FString::Printf(TEXT("Every acked operation is due by its grace period with %d pending"), NumOperations), NumDue, NumOperations * NumIterations);
+
+		const double OperationsMeasured = static_cast<double>(NumOperations) * NumIterations;
+		AddInfo(FString::Printf(TEXT("%4d pending: enqueue %.1f ns/op, lookup %.1f ns/op, ack %.1f ns/op"), NumOperations,
+			EnqueueSeconds * 1e9 / OperationsMeasured, LookupSeconds * 1e9 / OperationsMeasured, AckSeconds * 1e9 / OperationsMeasured));
+	}
+
+	return true;
+}
+
+#endif
@@ -4,7 +4,10 @@
 
 #include "CoreMinimal.h"
 #include "GameplayTagContainer.h"
+#include "GMCAbilitySystem.h"
 #include "GMCMovementUtilityComponent.h"
+#include "GMASClassRegistry.h"
+#include "GMASIdAllocator.h"
 #include "InstancedStruct.h"
 #include "UObject/Object.h"
 #include "UObject/ConstructorHelpers.h"
@@ -48,6 +51,10 @@ struct GMCABILITYSYSTEM_API FGMASBoundQueueRPCHeader
 	UPROPERTY()
 	FGameplayTag Tag { FGameplayTag::EmptyTag };
 
+	// Classes known to the class registry are sent as their net ID; anything else is sent by path.
+	UPROPERTY()
+	uint16 ItemClassNetId { FGMASClassRegistry::InvalidNetId };
+
 	UPROPERTY()
 	FName ItemClassName { NAME_None };
 
@@ -62,6 +69,44 @@ struct GMCABILITYSYSTEM_API FGMASBoundQueueRPCHeader
 
 	UPROPERTY()
 	uint8 ExtraFlags { 0 };
+
+	// Grace periods are sent in steps of this many seconds.
+	static constexpr float GracePeriodResolution = 0.05f;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+	{
+		return NetSerializeRelativeTo(Ar, Map, bOutSuccess, 0);
+	}
+
+	// Fields are only written when they differ from their defaults, and IDs are written as varints relative to
+	// BaseOperationId (the previous header's ID when sending several), so a typical header packs into a few bytes.
+	bool NetSerializeRelativeTo(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess, int32 BaseOperationId);
+
+	// Copy another header into this one, reusing our payload ID and instanced payload storage where we can.
+	void AssignFrom(const FGMASBoundQueueRPCHeader& Other);
+
+	// Assign Value to an instanced struct, in place if it already holds one of the same type.
+	template<typename S>
+	static void AssignInstanced(FInstancedStruct& Instanced, const S& Value)
+	{
+		if (S* Existing = Instanced.GetMutablePtr<S>())
+		{
+			*Existing = Value;
+		}
+		else
+		{
+			Instanced.InitializeAs<S>(Value);
+		}
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FGMASBoundQueueRPCHeader> : public TStructOpsTypeTraitsBase2<FGMASBoundQueueRPCHeader>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
 };
 
 template<typename C, typename T>
@@ -77,10 +122,6 @@ struct GMCABILITYSYSTEM_API TGMASBoundQueueOperation
 	// The struct payload for this item.
 	T Payload;	
 
-	// The instanced struct representation of this payload, used to actually
-	// bind for replication.
-	FInstancedStruct InstancedPayload;
-
 	EGMASBoundQueueOperationType GetOperationType() const
 	{
 		return Header.GetOperationType();
@@ -97,17 +138,21 @@ struct GMCABILITYSYSTEM_API TGMASBoundQueueOperation
 
 	FGameplayTag GetTag() const { return Header.Tag; }
 
-	bool GracePeriodExpired() const
-	{
-		return Header.RPCGracePeriodSeconds <= 0.f;
-	}
+	// When this operation's grace period runs out, on its queue's grace clock. Only set while in the RPC queue.
+	double GraceDeadline { 0 };
+
+	// The order operations were queued in across all bound lanes. Only set while in a bound lane.
+	uint32 QueueSequence { 0 };
+
+	// Set on an operation removed from a bound lane; its slot is skipped when draining until the lane is compacted.
+	bool bRemovedFromLane { false };
 
 	bool IsValid() const
 	{
-		return Header.OperationTypeRaw != 0 && (Header.ItemClassName != NAME_None || Header.Tag != FGameplayTag::EmptyTag || Header.PayloadIds.Ids.Num() > 0);
+		return Header.OperationTypeRaw != 0 && (Header.ItemClassNetId != FGMASClassRegistry::InvalidNetId || Header.ItemClassName != NAME_None || Header.Tag != FGameplayTag::EmptyTag || Header.PayloadIds.Ids.Num() > 0);
 	}
 
-	void Refresh(bool bDecodePayload = false)
+	void Refresh(bool bDecodePayload = false, const FGMASClassRegistry* ClassRegistry = nullptr)
 	{
 		if (bDecodePayload)
 		{
@@ -121,49 +166,166 @@ struct GMCABILITYSYSTEM_API TGMASBoundQueueOperation
 		else
 		{
 			// Outgoing
-			Header.InstancedPayload = FInstancedStruct::Make<T>(Payload);
-			InstancedPayloadIds = FInstancedStruct::Make<FGMASBoundQueueOperationIdSet>(Header.PayloadIds);
+			FGMASBoundQueueRPCHeader::AssignInstanced(Header.InstancedPayload, Payload);
+			FGMASBoundQueueRPCHeader::AssignInstanced(InstancedPayloadIds, Header.PayloadIds);
+		}
+
+		RefreshClass(ClassRegistry);
+	}
+
+	bool IsEncoded() const
+	{
+		return Header.InstancedPayload.template GetPtr<T>() != nullptr;
+	}
+
+	// Decode a received header into this operation, reusing our existing payload storage.
+	void DecodeFrom(const FGMASBoundQueueRPCHeader& InHeader, const FGMASClassRegistry* ClassRegistry = nullptr)
+	{
+		Header.AssignFrom(InHeader);
+		ItemClass = nullptr;
+
+		if (const T* InPayload = Header.InstancedPayload.template GetPtr<T>())
+		{
+			Payload = *InPayload;
+		}
+		else
+		{
+			Payload = T();
 		}
 
-		RefreshClass();
+		RefreshClass(ClassRegistry);
 	}
 
-	void RefreshClass()
+	void RefreshClass(const FGMASClassRegistry* ClassRegistry = nullptr)
 	{
-		if (Header.ItemClassName != NAME_None && !ItemClass)
+		if (!ItemClass && Header.ItemClassNetId != FGMASClassRegistry::InvalidNetId)
+		{
+			ItemClass = ClassRegistry ? ClassRegistry->GetClass<C>(Header.ItemClassNetId) : nullptr;
+			if (!ItemClass)
+			{
+				UE_LOG(LogGMCAbilitySystem, Error, TEXT("Queued operation %d references unknown class net ID %d."), Header.OperationId, Header.ItemClassNetId);
+			}
+		}
+		else if (!ItemClass && Header.ItemClassName != NAME_None)
 		{
 			// Get a handle to our class, for instancing purposes.
 			TSoftClassPtr<C> ClassPtr = TSoftClassPtr<C>(FSoftObjectPath(Header.ItemClassName.ToString()));
 			ItemClass = ClassPtr.LoadSynchronous();
 		}
 
-		if (ItemClass && Header.ItemClassName == NAME_None)
+		if (ItemClass && Header.ItemClassNetId == FGMASClassRegistry::InvalidNetId && Header.ItemClassName == NAME_None)
 		{
-			Header.ItemClassName = FName(ItemClass->GetPathName());
+			Header.ItemClassNetId = ClassRegistry ? ClassRegistry->GetNetId(ItemClass) : FGMASClassRegistry::InvalidNetId;
+			if (Header.ItemClassNetId == FGMASClassRegistry::InvalidNetId)
+			{
+				Header.ItemClassName = FName(ItemClass->GetPathName());
+			}
 		}
 	}
 	
 };
 
+// Acknowledged operation IDs, as a window of bits starting at BaseId. Operation IDs are seeded from the action
+// timer, so acks which are close in time are close in ID and the window stays a word or two wide; old acks expire
+// by sliding the window forward rather than by tracking a lifetime per ack.
 USTRUCT(BlueprintType)
-struct GMCABILITYSYSTEM_API FGMASBoundQueueAcknowledgement
+struct GMCABILITYSYSTEM_API FGMASBoundQueueAckWindow
 {
 	GENERATED_BODY()
 
+	static constexpr int32 NumWords = 8;
+	static constexpr int32 NumBits = NumWords * 64;
+
 	UPROPERTY()
-	int32 Id { -1 };
+	int32 BaseId { 0 };
 
 	UPROPERTY()
-	float Lifetime { 5.f };
+	uint64 Bits[NumWords] { 0 };
+
+	// Returns false if the ID is too far behind the window's newest ack to be recorded. An ID too far ahead of the
+	// oldest ack slides the window forward, and bOutDroppedAcks says whether any acks were pushed out by it.
+	bool Add(int32 Id, bool& bOutDroppedAcks);
+	bool Add(int32 Id)
+	{
+		bool bDroppedAcks;
+		return Add(Id, bDroppedAcks);
+	}
+
+	bool Contains(int32 Id) const
+	{
+		const int64 Offset = static_cast<int64>(Id) - BaseId;
+		return Offset >= 0 && Offset < NumBits && (Bits[Offset / 64] & (1ull << (Offset % 64))) != 0;
+	}
+
+	// Forget every ack older than MinId.
+	void ExpireBefore(int32 MinId);
+
+	bool IsEmpty() const;
+
+	template<typename F>
+	void ForEach(F&& Func) const
+	{
+		for (int32 Word = 0; Word < NumWords; Word++)
+		{
+			for (uint64 Remaining = Bits[Word]; Remaining != 0; Remaining &= Remaining - 1)
+			{
+				Func(static_cast<int32>(BaseId + static_cast<int64>(Word) * 64 + FMath::CountTrailingZeros64(Remaining)));
+			}
+		}
+	}
+
+	void Reset();
+
+	// Only the base and the words up to the newest ack are sent, as varints.
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	bool operator==(const FGMASBoundQueueAckWindow& Other) const
+	{
+		return BaseId == Other.BaseId && FMemory::Memcmp(Bits, Other.Bits, sizeof(Bits)) == 0;
+	}
+
+private:
+
+	int32 GetLowestBit() const;
+	int32 GetHighestBit() const;
+
+	void ShiftDown(int32 NumBitsToShift);
+	void ShiftUp(int32 NumBitsToShift);
+
+	// Slide the window forward so that it starts at the oldest ack.
+	void Compact();
 };
 
+template<>
+struct TStructOpsTypeTraits<FGMASBoundQueueAckWindow> : public TStructOpsTypeTraitsBase2<FGMASBoundQueueAckWindow>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true,
+	};
+};
+
+// The operations riding a single move.
 USTRUCT(BlueprintType)
-struct GMCABILITYSYSTEM_API FGMASBoundQueueAcknowledgements
+struct GMCABILITYSYSTEM_API FGMASBoundQueueOperationBatch
 {
 	GENERATED_BODY()
 
 	UPROPERTY()
-	TArray<FGMASBoundQueueAcknowledgement> AckSet;
+	TArray<FGMASBoundQueueRPCHeader> Operations;
+
+	// Operation IDs are sent relative to the previous operation's.
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FGMASBoundQueueOperationBatch> : public TStructOpsTypeTraitsBase2<FGMASBoundQueueOperationBatch>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
 };
 
 USTRUCT(BlueprintType)
@@ -178,31 +340,82 @@ class GMCABILITYSYSTEM_API TGMASBoundQueue
 
 public:
 
-	TGMASBoundQueueOperation<C, T> CurrentOperation;
+	// One lane per operation type.
+	static constexpr int32 NumLanes = static_cast<int32>(EGMASBoundQueueOperationType::Cancel) + 1;
+
+	// The operations of the current move (an FGMASBoundQueueOperationBatch), drained from QueuedBoundLanes in
+	// LaneDrainOrder, and in FIFO order within each lane. Client-auth queues bind the whole batch, so every
+	// operation queued before a move lands in that move.
+	FInstancedStruct CurrentOperations;
+
+	// How many operations can ride a single move; anything beyond that waits for the next one.
+	int32 MaxOperationsPerMove { 4 };
+
+	// Which lanes are drained first when more operations are queued than fit in a move. Cancels and removals go
+	// first, so that whatever they stop is stopped on the next move rather than rolled back later; lanes missing
+	// from this list are drained last, in type order. A cancel or removal never overtakes an activation or addition
+	// of the same target queued before it, though, or it would find nothing to stop.
+	TArray<EGMASBoundQueueOperationType> LaneDrainOrder {
+		EGMASBoundQueueOperationType::Cancel,
+		EGMASBoundQueueOperationType::Remove,
+		EGMASBoundQueueOperationType::Activate,
+		EGMASBoundQueueOperationType::Add
+	};
+
+	// Used to send operation classes as net IDs; owned by the ability component.
+	const FGMASClassRegistry* ClassRegistry { nullptr };
 
 	int BI_ActionTimer { -1 };
 	int BI_Acknowledgements { -1 };
-	int BI_OperationId { -1 };
-	int BI_OperationType { -1 };
-	int BI_OperationTag { -1 };
-	int BI_OperationClass { -1 };
-	int BI_OperationExtraFlags { -1 };
-	int BI_OperationPayload { -1 };
-	int BI_OperationPayloadIds { -1 };
+	int BI_CurrentOperations { -1 };
 	
-	TArray<TGMASBoundQueueOperation<C, T>> QueuedBoundOperations;
+	// Movement-synced operations waiting for a move, one lane per operation type.
+	TArray<TGMASBoundQueueOperation<C, T>> QueuedBoundLanes[NumLanes];
 	TArray<TGMASBoundQueueOperation<C, T>> QueuedRPCOperations;
 
+	// An FGMASBoundQueueAckWindow; bound for server-auth queues so the client can acknowledge operations.
 	FInstancedStruct Acknowledgments;
 
+	// How long an acknowledgement is remembered for. Keep this under FGMASBoundQueueAckWindow::NumBits IDs'
+	// worth of time (FGMASIdAllocator::IdsPerSecond), so that expiry rather than overflow keeps the window in range.
+	float AckLifetimeSeconds { 5.f };
+
 	double ActionTimer { 0 };
 
-	void BindToGMC(UGMC_MovementUtilityCmp* MovementComponent)
+	// Advanced by AdvanceGraceClock; RPC operations' grace periods are deadlines on this clock.
+	double GraceClock { 0 };
+
+	// Where every queued operation lives, plus ref-counted payload IDs and tag/type counts for both queues, so that
+	// lookups, ID generation and duplicate checks never have to scan or copy the queues. Maintained by
+	// IndexOperation/UnindexOperation; only modify the queues through this class.
+	struct FQueuedOperationLocation
+	{
+		int32 Index;
+		bool bRPC;
+		uint8 Lane;
+	};
+	TMap<int32, FQueuedOperationLocation> QueuedOperationLocations;
+	TMap<int32, int32> RPCPayloadIdRefs;
+	TMap<int32, int32> BoundPayloadIdRefs;
+	TMap<FGameplayTag, int32> QueuedTagCounts;
+	TMap<TPair<FGameplayTag, uint8>, int32> QueuedTagTypeCounts;
+
+	// Set the queue up without binding anything, for a queue that never has a client to sync with.
+	void InitializeUnbound()
+	{
+		Acknowledgments = FInstancedStruct::Make<FGMASBoundQueueAckWindow>();
+		CurrentOperations = FInstancedStruct::Make<FGMASBoundQueueOperationBatch>();
+	}
+
+	// MovementComponentType is normally UGMC_MovementUtilityCmp; anything with the same Bind* functions will do, which
+	// lets the queue be exercised without a movement component.
+	template<typename MovementComponentType = UGMC_MovementUtilityCmp>
+	void BindToGMC(MovementComponentType* MovementComponent)
 	{
 		const EGMC_PredictionMode Prediction = ClientAuth ? EGMC_PredictionMode::ClientAuth_Input : EGMC_PredictionMode::ServerAuth_Input_ClientValidated;
 		const EGMC_PredictionMode AckPrediction = ClientAuth ? EGMC_PredictionMode::ServerAuth_Output_ClientValidated : EGMC_PredictionMode::ClientAuth_Input;
 		
-		Acknowledgments = FInstancedStruct::Make<FGMASBoundQueueAcknowledgements>(FGMASBoundQueueAcknowledgements());
+		InitializeUnbound();
 
 		// Our queue's action timer is always server-auth.
 		BI_ActionTimer = MovementComponent->BindDoublePrecisionFloat(
@@ -225,114 +438,72 @@ public:
 		}
 		else
 		{
-			// For client-auth stuff, we bind the individual pieces of the queue.
+			// For client-auth stuff, we bind the operations of the current move.
 			// We will probably not use this often (if ever), but it exists just-in-case.
-			
-			BI_OperationId = MovementComponent->BindInt(
-				CurrentOperation.Header.OperationId,
-				Prediction,
-				EGMC_CombineMode::CombineIfUnchanged,
-				EGMC_SimulationMode::Periodic_Output,
-				EGMC_InterpolationFunction::TargetValue);
-
-			BI_OperationType = MovementComponent->BindByte(
-				CurrentOperation.Header.OperationTypeRaw,
-				Prediction,
-				EGMC_CombineMode::CombineIfUnchanged,
-				EGMC_SimulationMode::Periodic_Output,
-				EGMC_InterpolationFunction::TargetValue);
-
-			BI_OperationTag = MovementComponent->BindGameplayTag(
-				CurrentOperation.Header.Tag,
-				Prediction,
-				EGMC_CombineMode::CombineIfUnchanged,
-				EGMC_SimulationMode::Periodic_Output,
-				EGMC_InterpolationFunction::TargetValue);
-
-			BI_OperationClass = MovementComponent->BindName(
-				CurrentOperation.Header.ItemClassName,
-				Prediction,
-				EGMC_CombineMode::CombineIfUnchanged,
-				EGMC_SimulationMode::Periodic_Output,
-				EGMC_InterpolationFunction::TargetValue);
-
-			BI_OperationPayload = MovementComponent->BindInstancedStruct(
-				CurrentOperation.Header.InstancedPayload,
-				Prediction,
-				EGMC_CombineMode::CombineIfUnchanged,
-				EGMC_SimulationMode::Periodic_Output,
-				EGMC_InterpolationFunction::TargetValue);
-
-			BI_OperationExtraFlags = MovementComponent->BindByte(
-				CurrentOperation.Header.ExtraFlags,
-				Prediction,
-				EGMC_CombineMode::CombineIfUnchanged,
-				EGMC_SimulationMode::Periodic_Output,
-				EGMC_InterpolationFunction::TargetValue);
-
-			BI_OperationPayloadIds = MovementComponent->BindInstancedStruct(
-				CurrentOperation.InstancedPayloadIds,
+			BI_CurrentOperations = MovementComponent->BindInstancedStruct(
+				CurrentOperations,
 				Prediction,
 				EGMC_CombineMode::CombineIfUnchanged,
 				EGMC_SimulationMode::Periodic_Output,
 				EGMC_InterpolationFunction::TargetValue);
 		}
-
-		CurrentOperation = TGMASBoundQueueOperation<C, T>();
-		CurrentOperation.Header = FGMASBoundQueueRPCHeader();
-		CurrentOperation.Refresh(false);
 	}
 	
 	void PreLocalMovement()
 	{
-		if (QueuedBoundOperations.Num() > 0 && ClientAuth)
+		if (NumQueuedBoundOperations > 0 && ClientAuth)
 		{
-			CurrentOperation = QueuedBoundOperations.Pop();
-			CurrentOperation.Refresh(false);
+			TakeNextOperations();
 		}
 	}
 
 	void PreRemoteMovement()
 	{
-		ClearCurrentOperation();
-		if (QueuedBoundOperations.Num() > 0 && !ClientAuth)
+		if (NumQueuedBoundOperations > 0 && !ClientAuth)
 		{
-			CurrentOperation = QueuedBoundOperations.Pop();
-			CurrentOperation.Refresh(false);
+			TakeNextOperations();
+		}
+		else
+		{
+			ClearCurrentOperation();
 		}
 	}
 
 	int32 GenerateOperationId() const
 	{
-		int32 NewOperationId = ActionTimer * 100;
+		return FGMASIdAllocator::Allocate(ActionTimer, [this](int32 Id) { return QueuedOperationLocations.Contains(Id); });
+	}
 
-		TGMASBoundQueueOperation<C, T> Operation;
-		
-		while (GetOperationById(NewOperationId, Operation))
-		{
-			NewOperationId++;
-		}
-		return NewOperationId;
+	bool HasOperationWithId(int32 OperationId) const
+	{
+		return QueuedOperationLocations.Contains(OperationId);
+	}
+
+	bool HasRPCOperationWithPayloadId(int32 PayloadId) const
+	{
+		return RPCPayloadIdRefs.Contains(PayloadId);
 	}
 	
 	void ClearCurrentOperation()
 	{
-		CurrentOperation.Header = FGMASBoundQueueRPCHeader();
-		
-		// CurrentOperation.Header.OperationId = -1;
-		// CurrentOperation.Header.Tag = FGameplayTag::EmptyTag;
-		// CurrentOperation.Header.ItemClassName = NAME_None;
-		// CurrentOperation.SetOperationType(EGMASBoundQueueOperationType::None);
-		// CurrentOperation.Header.PayloadIds.Ids.Empty();
-		
-		CurrentOperation.Payload = T();
-		CurrentOperation.Refresh(false);
+		if (FGMASBoundQueueOperationBatch* Batch = CurrentOperations.GetMutablePtr<FGMASBoundQueueOperationBatch>())
+		{
+			// Nothing to do for an idle queue.
+			if (Batch->Operations.Num() > 0)
+			{
+				Batch->Operations.Reset();
+			}
+		}
+		else
+		{
+			CurrentOperations.InitializeAs<FGMASBoundQueueOperationBatch>();
+		}
 	}
 
 	void GenPredictionTick(float DeltaTime)
 	{
 		ActionTimer += DeltaTime;
-		ExpireStaleAcks(DeltaTime);
+		ExpireStaleAcks();
 	}
 
 	int32 MakeOperation(TGMASBoundQueueOperation<C, T>& NewOperation, EGMASBoundQueueOperationType Type, FGameplayTag Tag, const T& Payload, TArray<int> PayloadIds = {}, TSubclassOf<C> ItemClass = nullptr, float RPCGracePeriod = 1.f, uint8 ExtraFlags = 0)
@@ -346,7 +517,7 @@ public:
 		NewOperation.Header.PayloadIds.Ids = PayloadIds;
 		NewOperation.Header.ExtraFlags = ExtraFlags;
 
-		NewOperation.Refresh(false);
+		NewOperation.Refresh(false, ClassRegistry);
 		
 		return NewOperation.GetOperationId();
 	}
@@ -355,28 +526,42 @@ public:
 	{
 		NewOperation.Header = Header;
 		NewOperation.Payload = Payload;
-		NewOperation.Refresh();
-		NewOperation.InstancedPayload = FInstancedStruct::Make<T>(Payload);
-		NewOperation.InstancedPayloadIds = FInstancedStruct::Make<FGMASBoundQueueOperationIdSet>(NewOperation.Header.PayloadIds);
+		NewOperation.Refresh(false, ClassRegistry);
 
 		return NewOperation.GetOperationId();
 	}
 
-	void QueuePreparedOperation(TGMASBoundQueueOperation<C, T>& NewOperation, bool bMovementSynced = true)
+	// Clone an already-encoded operation (e.g. one effect being applied to many targets), only assigning a fresh
+	// operation ID and payload IDs. The instanced payload of the template is reused as-is rather than re-encoded.
+	int32 MakeOperationFromTemplate(TGMASBoundQueueOperation<C, T>& NewOperation, const TGMASBoundQueueOperation<C, T>& Template, const TArray<int>& PayloadIds)
 	{
-		TGMASBoundQueueOperation<C, T> TestOperation = TGMASBoundQueueOperation<C, T>();
+		NewOperation = Template;
+		NewOperation.Header.OperationId = GenerateOperationId();
+		NewOperation.Header.PayloadIds.Ids = PayloadIds;
+		FGMASBoundQueueRPCHeader::AssignInstanced(NewOperation.InstancedPayloadIds, NewOperation.Header.PayloadIds);
+
+		return NewOperation.GetOperationId();
+	}
 
+	void QueuePreparedOperation(TGMASBoundQueueOperation<C, T>& NewOperation, bool bMovementSynced = true)
+	{
 		// Don't bother queueing it if it already exists.
-		if (GetOperationById(NewOperation.GetOperationId(), TestOperation)) return;
+		if (HasOperationWithId(NewOperation.GetOperationId())) return;
 		
+		// Movement-synced operations need to be handled via GMC, so go in our bound queue.
+		const uint8 Lane = GetLane(NewOperation);
+		TArray<TGMASBoundQueueOperation<C, T>>& Queue = bMovementSynced ? QueuedBoundLanes[Lane] : QueuedRPCOperations;
+		const int32 Index = Queue.Add(NewOperation);
+		IndexOperation(Queue[Index], Index, !bMovementSynced);
+
 		if (bMovementSynced)
 		{
-			// This needs to be handled via GMC, so add it to our queue.
-			QueuedBoundOperations.Push(NewOperation);
+			Queue[Index].QueueSequence = NextQueueSequence++;
+			Queue[Index].bRemovedFromLane = false;
 		}
 		else
 		{
-			QueuedRPCOperations.Push(NewOperation);
+			TrackGraceDeadline(Queue[Index]);
 		}
 	}
 	
@@ -392,203 +577,474 @@ public:
 		TGMASBoundQueueOperation<C, T> NewOperation;
 
 		NewOperation.Header = Header;
-		NewOperation.Refresh(true);
+		NewOperation.Refresh(true, ClassRegistry);
 		QueuePreparedOperation(NewOperation, bMovementSynced);
 	}
 
 	int Num() const
 	{
-		return QueuedBoundOperations.Num();
+		return NumQueuedBoundOperations;
 	}
 
 	int NumMatching(FGameplayTag Tag, EGMASBoundQueueOperationType Type = EGMASBoundQueueOperationType::None) const
 	{
-		int Result = 0;
-		for (const auto& Operation : QueuedBoundOperations)
+		const int32* Count = Type == EGMASBoundQueueOperationType::None ? QueuedTagCounts.Find(Tag)
+			: QueuedTagTypeCounts.Find(TPair<FGameplayTag, uint8>(Tag, static_cast<uint8>(Type)));
+		return Count ? *Count : 0;
+	}
+
+	// Visit the operations of one bound lane which haven't been taken or removed yet, oldest first.
+	template<typename FuncType>
+	void ForEachQueuedOperation(EGMASBoundQueueOperationType Type, FuncType&& Func) const
+	{
+		const int32 Lane = FMath::Min<int32>(static_cast<int32>(Type), NumLanes - 1);
+		const TArray<TGMASBoundQueueOperation<C, T>>& Queue = QueuedBoundLanes[Lane];
+		for (int32 Idx = LaneHeads[Lane]; Idx < Queue.Num(); Idx++)
 		{
-			if (Operation.GetTag() == Tag)
+			if (!Queue[Idx].bRemovedFromLane)
 			{
-				if (Type == EGMASBoundQueueOperationType::None || Operation.GetOperationType() == Type) Result++;
+				Func(Queue[Idx]);
 			}
 		}
+	}
+
+	const TArray<TGMASBoundQueueOperation<C, T>>& GetQueuedRPCOperations() const { return QueuedRPCOperations; }
+
+	// Copy-free lookup of a queued operation. The pointer is only valid until the queues are next modified.
+	const TGMASBoundQueueOperation<C, T>* FindOperationById(int32 OperationId) const
+	{
+		const FQueuedOperationLocation* Location = QueuedOperationLocations.Find(OperationId);
+		if (!Location) return nullptr;
+
+		return &GetQueue(*Location)[Location->Index];
+	}
+
+	bool GetOperationById(int32 OperationId, TGMASBoundQueueOperation<C, T>& OutOperation) const
+	{
+		if (const TGMASBoundQueueOperation<C, T>* Operation = FindOperationById(OperationId))
+		{
+			OutOperation = *Operation;
+			return true;
+		}
+
+		return false;
+	}
+
+	// IDs of the operations waiting in the RPC queue, for callers which need to process (and so modify) the queue
+	// while walking it.
+	template<typename AllocatorType>
+	void GetQueuedRPCOperationIds(TArray<int32, AllocatorType>& OutOperationIds) const
+	{
+		OutOperationIds.Reset(QueuedRPCOperations.Num());
 		for (const auto& Operation : QueuedRPCOperations)
 		{
-			if (Operation.GetTag() == Tag)
+			OutOperationIds.Add(Operation.GetOperationId());
+		}
+	}
+
+	bool HasOperationWithPayloadId(int32 PayloadId) const
+	{
+		return RPCPayloadIdRefs.Contains(PayloadId) || BoundPayloadIdRefs.Contains(PayloadId);
+	}
+
+	bool RemoveOperationById(int32 OperationId)
+	{
+		const FQueuedOperationLocation* Location = QueuedOperationLocations.Find(OperationId);
+		if (!Location) return false;
+
+		const int32 TargetIdx = Location->Index;
+		const bool bRPC = Location->bRPC;
+		const uint8 Lane = Location->Lane;
+		TArray<TGMASBoundQueueOperation<C, T>>& Queue = GetQueue(*Location);
+
+		UnindexOperation(Queue[TargetIdx]);
+		if (bRPC)
+		{
+#if ENGINE_MAJOR_VERSION >=5 && ENGINE_MINOR_VERSION >= 4
+			Queue.RemoveAtSwap(TargetIdx, 1, EAllowShrinking::No);
+#else
+			Queue.RemoveAtSwap(TargetIdx, 1, false);
+#endif
+
+			// The last operation was swapped into the freed slot.
+			if (Queue.IsValidIndex(TargetIdx))
+			{
+				QueuedOperationLocations.FindChecked(Queue[TargetIdx].GetOperationId()).Index = TargetIdx;
+			}
+		}
+		else
+		{
+			// Bound lanes drain in FIFO order, so rather than shift the rest of the lane up, leave the slot for
+			// draining to skip and CompactLane to reclaim.
+			Queue[TargetIdx].bRemovedFromLane = true;
+			NumRemovedInLane[Lane]++;
+			if (TargetIdx == LaneHeads[Lane])
 			{
-				if (Type == EGMASBoundQueueOperationType::None || Operation.GetOperationType() == Type) Result++;
+				LaneHeads[Lane] = SkipRemovedOperations(Lane, TargetIdx);
 			}
-		}		
-		return Result;
+			CompactLane(Lane);
+		}
+		return true;
+	}
+	
+	int32 NumCurrentBoundOperations() const
+	{
+		const FGMASBoundQueueOperationBatch* Batch = CurrentOperations.GetPtr<FGMASBoundQueueOperationBatch>();
+		return Batch ? Batch->Operations.Num() : 0;
 	}
 
-	const TArray<TGMASBoundQueueOperation<C, T>>& GetQueuedOperations() const { return QueuedBoundOperations; }
+	// Decode the Index'th operation of the current move, in the order they were queued. Operation's storage is
+	// reused, so pass the same one in for every index.
+	bool GetCurrentBoundOperation(int32 Index, TGMASBoundQueueOperation<C, T>& Operation) const
+	{
+		const FGMASBoundQueueOperationBatch* Batch = CurrentOperations.GetPtr<FGMASBoundQueueOperationBatch>();
+		if (!Batch || !Batch->Operations.IsValidIndex(Index)) return false;
 
-	const TArray<TGMASBoundQueueOperation<C, T>>& GetQueuedRPCOperations() const { return QueuedRPCOperations; }
+		const FGMASBoundQueueRPCHeader& Header = Batch->Operations[Index];
+		if (Header.GetOperationType() == EGMASBoundQueueOperationType::None) return false;
 
-	bool GetOperationById(int32 OperationId, TGMASBoundQueueOperation<C, T>& OutOperation) const
+		Operation.DecodeFrom(Header, ClassRegistry);
+		return true;
+	}
+
+	bool PopNextRPCOperation(TGMASBoundQueueOperation<C, T>& Operation)
+	{
+		if (QueuedRPCOperations.Num() == 0) return false;
+
+		Operation = QueuedRPCOperations.Pop();
+		UnindexOperation(Operation);
+		return true;
+	}
+
+	void AdvanceGraceClock(float DeltaTime)
+	{
+		GraceClock += DeltaTime;
+	}
+
+	bool IsGracePeriodExpired(const TGMASBoundQueueOperation<C, T>& Operation) const
+	{
+		return GraceClock >= Operation.GraceDeadline;
+	}
+
+	// IDs of the RPC operations which have been acknowledged or whose grace period has run out, without looking at
+	// any of the others. Expired operations are only reported once.
+	template<typename AllocatorType>
+	void GetDueRPCOperationIds(TArray<int32, AllocatorType>& OutOperationIds)
 	{
-		for (const auto& Operation : GetQueuedOperations())
+		OutOperationIds.Reset();
+
+		while (GraceDeadlines.Num() > 0 && GraceDeadlines.HeapTop().Deadline <= GraceClock)
 		{
-			if (Operation.GetOperationId() == OperationId)
+			FGraceDeadline Expired;
+#if ENGINE_MAJOR_VERSION >=5 && ENGINE_MINOR_VERSION >= 4
+			GraceDeadlines.HeapPop(Expired, EAllowShrinking::No);
+#else
+			GraceDeadlines.HeapPop(Expired, false);
+#endif
+
+			// Entries for operations which have since been removed (or replaced) are simply dropped.
+			const FQueuedOperationLocation* Location = QueuedOperationLocations.Find(Expired.OperationId);
+			if (Location && Location->bRPC && QueuedRPCOperations[Location->Index].GraceDeadline == Expired.Deadline)
 			{
-				OutOperation = Operation;
-				return true;
+				OutOperationIds.Add(Expired.OperationId);
 			}
 		}
 
-		for (const auto& Operation : GetQueuedRPCOperations())
+		if (const FGMASBoundQueueAckWindow* Acks = Acknowledgments.GetPtr<FGMASBoundQueueAckWindow>())
 		{
-			if (Operation.GetOperationId() == OperationId)
+			Acks->ForEach([&](int32 OperationId)
 			{
-				OutOperation = Operation;
-				return true;
-			}
+				const FQueuedOperationLocation* Location = QueuedOperationLocations.Find(OperationId);
+				if (Location && Location->bRPC)
+				{
+					OutOperationIds.AddUnique(OperationId);
+				}
+			});
 		}
+	}
 
-		return false;
+	void Acknowledge(int32 OperationId)
+	{
+		FGMASBoundQueueAckWindow* Acks = Acknowledgments.GetMutablePtr<FGMASBoundQueueAckWindow>();
+		if (!Acks) return;
+
+		// An operation which loses its ack just waits out its grace period, so only say so once.
+		bool bDroppedAcks = false;
+		if ((!Acks->Add(OperationId, bDroppedAcks) || bDroppedAcks) && !bWarnedAboutLostAcks)
+		{
+			UE_LOG(LogGMCAbilitySystem, Warning, TEXT("Bound queue acks span more than %d operation IDs; operations outside the window wait out their grace period instead. Not warning again for this queue."),
+				FGMASBoundQueueAckWindow::NumBits);
+			bWarnedAboutLostAcks = true;
+		}
 	}
 
-	bool HasOperationWithPayloadId(int32 PayloadId) const
+	bool IsAcknowledged(int32 OperationId) const
 	{
-		for (const auto& Operation : QueuedBoundOperations)
+		const FGMASBoundQueueAckWindow* Acks = Acknowledgments.GetPtr<FGMASBoundQueueAckWindow>();
+		return Acks && Acks->Contains(OperationId);
+	}
+
+	void ExpireStaleAcks()
+	{
+		// IDs are seeded from our action timer, so anything seeded before the ack lifetime has gone stale.
+		if (FGMASBoundQueueAckWindow* Acks = Acknowledgments.GetMutablePtr<FGMASBoundQueueAckWindow>())
 		{
-			if (Operation.GetPayloadIds().Contains(PayloadId))
+			if (ActionTimer > AckLifetimeSeconds)
 			{
-				return true;
+				Acks->ExpireBefore(FGMASIdAllocator::GetSeed(ActionTimer - AckLifetimeSeconds));
 			}
 		}
+	}
 
-		for (const auto& Operation : QueuedRPCOperations)
+private:
+
+	// Operations queued across all of our bound lanes.
+	int32 NumQueuedBoundOperations { 0 };
+
+	// Stamped on each bound operation as it's queued, so lanes can tell which of two operations came first.
+	uint32 NextQueueSequence { 0 };
+
+	// The first operation of each bound lane not yet taken (or removed). Taken operations are left in place in front
+	// of it until CompactLane reclaims them.
+	int32 LaneHeads[NumLanes] { 0 };
+
+	// Operations removed from each bound lane still holding a slot at or after its head.
+	int32 NumRemovedInLane[NumLanes] { 0 };
+
+	bool bWarnedAboutLostAcks { false };
+
+	// A min-heap of RPC operation grace deadlines. Removed operations are left in place and skipped when they
+	// reach the top.
+	struct FGraceDeadline
+	{
+		double Deadline;
+		int32 OperationId;
+
+		bool operator<(const FGraceDeadline& Other) const { return Deadline < Other.Deadline; }
+	};
+	TArray<FGraceDeadline> GraceDeadlines;
+
+	void TrackGraceDeadline(TGMASBoundQueueOperation<C, T>& Operation)
+	{
+		Operation.GraceDeadline = GraceClock + Operation.Header.RPCGracePeriodSeconds;
+
+		// Queues which never ask for due operations (i.e. clients) would otherwise collect stale entries forever, so
+		// rebuild from what's actually queued once they outnumber it.
+		if (GraceDeadlines.Num() >= QueuedRPCOperations.Num() * 2 + 16)
 		{
-			if (Operation.GetPayloadIds().Contains(PayloadId))
+			GraceDeadlines.Reset();
+			for (const auto& Queued : QueuedRPCOperations)
 			{
-				return true;
+				GraceDeadlines.Add({ Queued.GraceDeadline, Queued.GetOperationId() });
 			}
+			GraceDeadlines.Heapify();
+			return;
 		}
 
-		return false;		
+		GraceDeadlines.HeapPush({ Operation.GraceDeadline, Operation.GetOperationId() });
 	}
 
-	bool RemoveOperationById(int32 OperationId)
+	static uint8 GetLane(const TGMASBoundQueueOperation<C, T>& Operation)
 	{
-		int TargetIdx = -1;
+		return static_cast<uint8>(FMath::Min<int32>(Operation.Header.OperationTypeRaw, NumLanes - 1));
+	}
+
+	TArray<TGMASBoundQueueOperation<C, T>>& GetQueue(const FQueuedOperationLocation& Location)
+	{
+		return Location.bRPC ? QueuedRPCOperations : QueuedBoundLanes[Location.Lane];
+	}
+
+	const TArray<TGMASBoundQueueOperation<C, T>>& GetQueue(const FQueuedOperationLocation& Location) const
+	{
+		return Location.bRPC ? QueuedRPCOperations : QueuedBoundLanes[Location.Lane];
+	}
 
-		for (int Idx = 0; Idx < QueuedRPCOperations.Num() && TargetIdx == -1; Idx++)
+	void IndexOperation(const TGMASBoundQueueOperation<C, T>& Operation, int32 Index, bool bRPC)
+	{
+		QueuedOperationLocations.Add(Operation.GetOperationId(), { Index, bRPC, GetLane(Operation) });
+		NumQueuedBoundOperations += bRPC ? 0 : 1;
+
+		TMap<int32, int32>& PayloadIdRefs = bRPC ? RPCPayloadIdRefs : BoundPayloadIdRefs;
+		for (const int32 PayloadId : Operation.Header.PayloadIds.Ids)
 		{
-			if(QueuedRPCOperations[Idx].GetOperationId() == OperationId)
-			{
-				TargetIdx = Idx;
-			}
+			PayloadIdRefs.FindOrAdd(PayloadId)++;
+		}
+
+		QueuedTagCounts.FindOrAdd(Operation.GetTag())++;
+		QueuedTagTypeCounts.FindOrAdd(TPair<FGameplayTag, uint8>(Operation.GetTag(), Operation.Header.OperationTypeRaw))++;
+	}
+
+	void UnindexOperation(const TGMASBoundQueueOperation<C, T>& Operation)
+	{
+		FQueuedOperationLocation Location;
+		if (!QueuedOperationLocations.RemoveAndCopyValue(Operation.GetOperationId(), Location)) return;
+		NumQueuedBoundOperations -= Location.bRPC ? 0 : 1;
+
+		TMap<int32, int32>& PayloadIdRefs = Location.bRPC ? RPCPayloadIdRefs : BoundPayloadIdRefs;
+		for (const int32 PayloadId : Operation.Header.PayloadIds.Ids)
+		{
+			DecrementCount(PayloadIdRefs, PayloadId);
 		}
 
-		if (TargetIdx != -1)
+		DecrementCount(QueuedTagCounts, Operation.GetTag());
+		DecrementCount(QueuedTagTypeCounts, TPair<FGameplayTag, uint8>(Operation.GetTag(), Operation.Header.OperationTypeRaw));
+	}
+
+	// Move up to MaxOperationsPerMove operations from the bound lanes into the current move, highest priority lane
+	// first and oldest first within a lane, except that a lane whose next operation is waiting on an earlier one in
+	// another lane is skipped until that has been taken.
+	void TakeNextOperations()
+	{
+		FGMASBoundQueueOperationBatch* Batch = CurrentOperations.GetMutablePtr<FGMASBoundQueueOperationBatch>();
+		if (!Batch)
 		{
+			CurrentOperations.InitializeAs<FGMASBoundQueueOperationBatch>();
+			Batch = CurrentOperations.GetMutablePtr<FGMASBoundQueueOperationBatch>();
+		}
+
+		// Headers left over from the last move are overwritten in place rather than freed and rebuilt.
+		const int32 NumToTake = FMath::Min(NumQueuedBoundOperations, FMath::Max(MaxOperationsPerMove, 1));
 #if ENGINE_MAJOR_VERSION >=5 && ENGINE_MINOR_VERSION >= 4
-			QueuedRPCOperations.RemoveAtSwap(TargetIdx, 1, EAllowShrinking::No);
+		Batch->Operations.SetNum(NumToTake, EAllowShrinking::No);
 #else
-			QueuedRPCOperations.RemoveAtSwap(TargetIdx, 1, false);
+		Batch->Operations.SetNum(NumToTake, false);
 #endif
-			return true;
-		}
 
-		TargetIdx = -1;
-		for (int Idx = 0; Idx < QueuedBoundOperations.Num() && TargetIdx == -1; Idx++)
+		// The next operation to take from each lane.
+		int32 LaneCursors[NumLanes];
+		FMemory::Memcpy(LaneCursors, LaneHeads, sizeof(LaneCursors));
+
+		int32 NumTaken = 0;
+		while (NumTaken < NumToTake)
 		{
-			if(QueuedBoundOperations[Idx].GetOperationId() == OperationId)
+			const int32 Lane = GetNextLaneToTake(LaneCursors);
+			if (Lane == INDEX_NONE) break;
+
+			TGMASBoundQueueOperation<C, T>& Operation = QueuedBoundLanes[Lane][LaneCursors[Lane]];
+			LaneCursors[Lane] = SkipRemovedOperations(Lane, LaneCursors[Lane] + 1);
+			UnindexOperation(Operation);
+
+			// Operations are encoded when they're made; only re-encode if something bypassed that.
+			if (!Operation.IsEncoded())
 			{
-				TargetIdx = Idx;
+				Operation.Refresh(false, ClassRegistry);
 			}
+			Batch->Operations[NumTaken++].AssignFrom(Operation.Header);
 		}
-		
-		if (TargetIdx != -1)
+
+		if (NumTaken < NumToTake)
 		{
 #if ENGINE_MAJOR_VERSION >=5 && ENGINE_MINOR_VERSION >= 4
-			QueuedBoundOperations.RemoveAtSwap(TargetIdx, 1, EAllowShrinking::No);
+			Batch->Operations.SetNum(NumTaken, EAllowShrinking::No);
 #else
-			QueuedBoundOperations.RemoveAtSwap(TargetIdx, 1, false);
+			Batch->Operations.SetNum(NumTaken, false);
 #endif
-			return true;
 		}
 
-		return false;
-	}
-	
-	bool GetCurrentBoundOperation(TGMASBoundQueueOperation<C, T>& Operation, bool bRefresh = false)
-	{
-		Operation = CurrentOperation;
-		if (Operation.GetOperationType() != EGMASBoundQueueOperationType::None)
+		for (int32 Lane = 0; Lane < NumLanes; Lane++)
 		{
-			if (bRefresh)
-			{
-				Operation.Refresh(true);
-			}
-			else
-			{
-				Operation.RefreshClass();
-			}
-			return true;
-		}
+			if (LaneCursors[Lane] == LaneHeads[Lane]) continue;
 
-		return false;
+			LaneHeads[Lane] = LaneCursors[Lane];
+			CompactLane(Lane);
+		}
 	}
 
-	bool PopNextRPCOperation(TGMASBoundQueueOperation<C, T>& Operation)
+	// Reclaim the slots of a lane's taken and removed operations once they make up at least half of it, so that
+	// taking and removing stay O(1) amortized rather than shifting the rest of the lane up every time.
+	void CompactLane(int32 Lane)
 	{
-		if (QueuedRPCOperations.Num() == 0) return false;
+		TArray<TGMASBoundQueueOperation<C, T>>& Queue = QueuedBoundLanes[Lane];
+		if ((LaneHeads[Lane] + NumRemovedInLane[Lane]) * 2 < Queue.Num()) return;
 
-		Operation = QueuedRPCOperations.Pop();
-		return true;
+		int32 NumKept = 0;
+		for (int32 Idx = LaneHeads[Lane]; Idx < Queue.Num(); Idx++)
+		{
+			if (Queue[Idx].bRemovedFromLane) continue;
+
+			if (Idx != NumKept)
+			{
+				Queue[NumKept] = MoveTemp(Queue[Idx]);
+				QueuedOperationLocations.FindChecked(Queue[NumKept].GetOperationId()).Index = NumKept;
+			}
+			NumKept++;
+		}
+#if ENGINE_MAJOR_VERSION >=5 && ENGINE_MINOR_VERSION >= 4
+		Queue.SetNum(NumKept, EAllowShrinking::No);
+#else
+		Queue.SetNum(NumKept, false);
+#endif
+		LaneHeads[Lane] = 0;
+		NumRemovedInLane[Lane] = 0;
 	}
 
-	void DeductGracePeriod(float DeltaTime)
+	// The first operation of Lane at or after Idx which hasn't been removed. Removed operations passed over end up
+	// behind the lane's head, so they stop counting towards NumRemovedInLane.
+	int32 SkipRemovedOperations(int32 Lane, int32 Idx)
 	{
-		for (auto& Operation : QueuedRPCOperations)
+		const TArray<TGMASBoundQueueOperation<C, T>>& Queue = QueuedBoundLanes[Lane];
+		while (Idx < Queue.Num() && Queue[Idx].bRemovedFromLane)
 		{
-			Operation.Header.RPCGracePeriodSeconds -= DeltaTime;
+			NumRemovedInLane[Lane]--;
+			Idx++;
 		}
+		return Idx;
 	}
 
-	void Acknowledge(int32 OperationId, float AckLifetime = 5.f)
+	// The highest priority lane with an operation ready to take, or INDEX_NONE.
+	int32 GetNextLaneToTake(const int32 (&LaneCursors)[NumLanes]) const
 	{
-		if (!IsAcknowledged(OperationId))
+		// The configured order first, then every lane in type order to pick up anything it left out.
+		for (int32 OrderIdx = 0; OrderIdx < LaneDrainOrder.Num() + NumLanes; OrderIdx++)
 		{
-			FGMASBoundQueueAcknowledgement NewAck;
-			NewAck.Id = OperationId;
-			NewAck.Lifetime = AckLifetime;
+			const int32 Lane = OrderIdx < LaneDrainOrder.Num() ? static_cast<int32>(LaneDrainOrder[OrderIdx]) : OrderIdx - LaneDrainOrder.Num();
+			if (Lane < 0 || Lane >= NumLanes || LaneCursors[Lane] >= QueuedBoundLanes[Lane].Num()) continue;
 
-			auto& Acks = Acknowledgments.GetMutable<FGMASBoundQueueAcknowledgements>();
-			Acks.AckSet.Add(NewAck);
+			if (!IsWaitingOnEarlierOperation(QueuedBoundLanes[Lane][LaneCursors[Lane]], LaneCursors))
+			{
+				return Lane;
+			}
 		}
+		return INDEX_NONE;
 	}
 
-	bool IsAcknowledged(int32 OperationId) const
+	// Whether a cancel or removal targets an activation or addition which was queued before it and hasn't been taken
+	// yet. Operations target the same thing if they share a payload ID (e.g. an effect ID) or a tag (e.g. an input).
+	bool IsWaitingOnEarlierOperation(const TGMASBoundQueueOperation<C, T>& Operation, const int32 (&LaneCursors)[NumLanes]) const
 	{
-		const auto& Acks = Acknowledgments.Get<FGMASBoundQueueAcknowledgements>();
-		for (const auto& Ack : Acks.AckSet)
+		EGMASBoundQueueOperationType TargetType;
+		switch (Operation.GetOperationType())
 		{
-			if (Ack.Id == OperationId) return true;
+		case EGMASBoundQueueOperationType::Remove: TargetType = EGMASBoundQueueOperationType::Add; break;
+		case EGMASBoundQueueOperationType::Cancel: TargetType = EGMASBoundQueueOperationType::Activate; break;
+		default: return false;
+		}
+
+		const int32 TargetLane = static_cast<int32>(TargetType);
+		const TArray<TGMASBoundQueueOperation<C, T>>& TargetQueue = QueuedBoundLanes[TargetLane];
+		for (int32 Idx = LaneCursors[TargetLane]; Idx < TargetQueue.Num() && TargetQueue[Idx].QueueSequence < Operation.QueueSequence; Idx++)
+		{
+			const TGMASBoundQueueOperation<C, T>& Target = TargetQueue[Idx];
+			if (Target.bRemovedFromLane) continue;
+
+			if (Operation.GetTag().IsValid() && Operation.GetTag() == Target.GetTag()) return true;
+
+			for (const int32 PayloadId : Operation.Header.PayloadIds.Ids)
+			{
+				if (Target.Header.PayloadIds.Ids.Contains(PayloadId)) return true;
+			}
 		}
 		return false;
 	}
 
-	void ExpireStaleAcks(float DeltaTime)
+	template<typename KeyType>
+	static void DecrementCount(TMap<KeyType, int32>& Counts, const KeyType& Key)
 	{
-		// Deduct from our ack lifetime; if we've gone stale, remove the stale acks to avoid it just growing forever.
-		TArray<FGMASBoundQueueAcknowledgement> FreshAcks;
-		if (!Acknowledgments.IsValid()) { // that fix the crash, but doesn't fix the issue. @packetdancer
-			return;
-		}
-			
-		auto& Acks = Acknowledgments.GetMutable<FGMASBoundQueueAcknowledgements>();
-		for (auto& Ack : Acks.AckSet)
+		int32* Count = Counts.Find(Key);
+		if (Count && --(*Count) <= 0)
 		{
-			Ack.Lifetime -= DeltaTime;
-			if (Ack.Lifetime > 0.f)
-			{
-				FreshAcks.Add(Ack);
-			}
+			Counts.Remove(Key);
 		}
-		Acks.AckSet = FreshAcks;
 	}
 	
 };
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/SubclassOf.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/SoftObjectPtr.h"
+
+struct FStreamableHandle;
+
+/**
+ * Maps the effect and ability classes a component knows about up front to small net IDs, so queued operations can
+ * refer to their class with an integer rather than its path.
+ *
+ * The registry is built from the component's defaults, sorted by path, so machines with the same content assign the
+ * same IDs. Its hash is compared with the other side's before any net ID is handed out: until they are known to match
+ * (or if they never do, e.g. after a content patch or a different load order), and for classes outside the registry,
+ * classes are sent by path.
+ */
+struct GMCABILITYSYSTEM_API FGMASClassRegistry
+{
+	static constexpr uint16 InvalidNetId = 0;
+
+	// Register the classes, replacing any previous registrations, and start loading those which aren't loaded yet.
+	void Build(TArray<FSoftObjectPath> ClassPaths);
+
+	void Reset();
+
+	// A hash of the registered paths in net ID order, to compare against the other side's registry.
+	uint32 GetHash() const { return Hash; }
+
+	// Whether the other side's registry hash matches ours, so that net IDs resolve to the same classes there.
+	void SetPeerMatches(bool bMatches) { bPeerMatches = bMatches; }
+	bool DoesPeerMatch() const { return bPeerMatches; }
+
+	// The net ID to send for a class; InvalidNetId if it has to be sent by path.
+	uint16 GetNetId(const UClass* Class) const;
+
+	// Resolve a net ID, falling back to a synchronous load if the preload hasn't finished with that class yet.
+	UClass* GetClass(uint16 NetId) const;
+
+	template<typename C>
+	TSubclassOf<C> GetClass(uint16 NetId) const
+	{
+		UClass* Class = GetClass(NetId);
+		return Class && Class->IsChildOf(C::StaticClass()) ? Class : nullptr;
+	}
+
+	int32 Num() const { return Classes.Num(); }
+
+private:
+
+	// Indexed by net ID - 1.
+	TArray<TSoftClassPtr<UObject>> Classes;
+	TMap<FSoftObjectPath, uint16> NetIdsByPath;
+
+	// Resolved lookups, hits and misses alike, so hot paths don't rebuild class paths.
+	mutable TMap<TObjectKey<UClass>, uint16> NetIdsByClass;
+
+	TSharedPtr<FStreamableHandle> PreloadHandle;
+
+	uint32 Hash { 0 };
+	bool bPeerMatches { false };
+};
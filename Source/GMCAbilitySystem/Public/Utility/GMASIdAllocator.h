@@ -0,0 +1,126 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Deterministic network ID generation, shared by effects, abilities and bound queue operations.
+ *
+ * IDs are seeded from the GMC action timer, so a client and server generating an ID at the same point in the
+ * movement stream, with the same IDs already in use, agree on it without any further communication. The seed is
+ * folded into the positive int32 range so long sessions wrap around rather than overflow, and collisions are
+ * resolved by probing forward. The in-use test is supplied by the caller and is expected to be a hashed lookup.
+ */
+struct FGMASIdAllocator
+{
+	static constexpr int32 InvalidId = -1;
+
+	// Resolution of the action timer seed; one ID per 10ms, matching the historical ActionTimer * 100 scheme.
+	static constexpr int32 IdsPerSecond = 100;
+
+	// Give up rather than spin forever if a caller's in-use set is somehow saturated.
+	static constexpr int32 MaxProbes = 1 << 16;
+
+	// IDs live in [1, MAX_int32); zero means "not yet assigned" and negatives are invalid.
+	static int32 GetSeed(double ActionTimer)
+	{
+		const int64 Ticks = FMath::Max<int64>(static_cast<int64>(ActionTimer * IdsPerSecond), 0);
+		const int32 Seed = static_cast<int32>(Ticks % MAX_int32);
+		return Seed > 0 ? Seed : 1;
+	}
+
+	static int32 GetNext(int32 Id)
+	{
+		return Id >= MAX_int32 - 1 ? 1 : Id + 1;
+	}
+
+	template<typename InUsePredicate>
+	static int32 Allocate(double ActionTimer, InUsePredicate&& IsInUse)
+	{
+		int32 Id = GetSeed(ActionTimer);
+		for (int32 Probe = 0; Probe < MaxProbes; Probe++)
+		{
+			if (!IsInUse(Id)) return Id;
+			Id = GetNext(Id);
+		}
+		return InvalidId;
+	}
+};
+
+/**
+ * Local-only handles with a generation counter per slot, so a handle held past its release never resolves to
+ * whatever reuses the slot. Allocation and validation are O(1); handles are positive ints, safe for Blueprint.
+ */
+struct FGMASHandleAllocator
+{
+	static constexpr int32 InvalidHandle = -1;
+	static constexpr int32 IndexBits = 20;
+	static constexpr int32 IndexMask = (1 << IndexBits) - 1;
+	static constexpr int32 GenerationMask = (1 << (31 - IndexBits)) - 1;
+
+	int32 Allocate()
+	{
+		int32 Index;
+		if (FreeIndices.Num() > 0)
+		{
+#if ENGINE_MAJOR_VERSION >=5 && ENGINE_MINOR_VERSION >= 4
+			Index = FreeIndices.Pop(EAllowShrinking::No);
+#else
+			Index = FreeIndices.Pop(false);
+#endif
+		}
+		else
+		{
+			// Slot indices are stored off by one so that a handle is never zero.
+			if (Generations.Num() >= IndexMask) return InvalidHandle;
+			Index = Generations.Add(0);
+			bLive.Add(false);
+		}
+
+		bLive[Index] = true;
+		return (Generations[Index] << IndexBits) | (Index + 1);
+	}
+
+	bool Release(int32 Handle)
+	{
+		if (!IsValid(Handle)) return false;
+
+		const int32 Index = GetIndex(Handle);
+		Generations[Index] = (Generations[Index] + 1) & GenerationMask;
+		bLive[Index] = false;
+		FreeIndices.Push(Index);
+		return true;
+	}
+
+	bool IsValid(int32 Handle) const
+	{
+		if (Handle <= 0) return false;
+
+		const int32 Index = GetIndex(Handle);
+		return Generations.IsValidIndex(Index) && bLive[Index] && Generations[Index] == (Handle >> IndexBits);
+	}
+
+	int32 Num() const { return Generations.Num() - FreeIndices.Num(); }
+
+	void Reset()
+	{
+		// Bump every live slot's generation rather than clearing, so outstanding handles stay invalid.
+		FreeIndices.Reset();
+		for (int32 Index = Generations.Num() - 1; Index >= 0; Index--)
+		{
+			if (bLive[Index])
+			{
+				Generations[Index] = (Generations[Index] + 1) & GenerationMask;
+				bLive[Index] = false;
+			}
+			FreeIndices.Push(Index);
+		}
+	}
+
+private:
+
+	static int32 GetIndex(int32 Handle) { return (Handle & IndexMask) - 1; }
+
+	TArray<int32> Generations;
+	TBitArray<> bLive;
+	TArray<int32> FreeIndices;
+};